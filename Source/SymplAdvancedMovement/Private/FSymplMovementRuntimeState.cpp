@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FSymplMovementRuntimeState.h"
+
+//The fields every tick reads have to stay in the first cache line.
+static_assert(STRUCT_OFFSET(FSymplMovementRuntimeState, CurrentVelocity) + sizeof(FVector) <= PLATFORM_CACHE_LINE_SIZE, "Per frame runtime state no longer fits a cache line.");
+
+FArchive& operator<<(FArchive& Ar, FSymplMovementRuntimeState& State)
+{
+	uint8 bits = (State.bDidJump ? 1 : 0) | (State.bAutoRunEnabled ? 2 : 0) | (State.bInitialized ? 4 : 0);
+	Ar << State.MovementStateFlags << State.CurrentMovementMode << State.LastMovementMode << State.CurrentMovementType << bits;
+	Ar << State.DoubleJumpCounter << State.CurrentSpeed << State.CurrentSlopeAngle << State.CurrentSlopeSpeedScalar << State.CurrentVelocity;
+	Ar << State.ForwardInput << State.RightInput << State.UpInput;
+	Ar << State.ClimbStartTime << State.RollStartTime << State.DashStartTime << State.BlinkStartTime << State.SlideStartTime << State.HoverStartTime;
+	Ar << State.JetpackFuel << State.SprintStamina;
+	Ar << State.CurrentDashDirection << State.CurrentBlinkDirection << State.CurrentRollDirection;
+	if (Ar.IsLoading())
+	{
+		State.bDidJump = (bits & 1) != 0;
+		State.bAutoRunEnabled = (bits & 2) != 0;
+		State.bInitialized = (bits & 4) != 0;
+	}
+	return Ar;
+}
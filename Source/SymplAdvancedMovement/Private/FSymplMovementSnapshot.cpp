@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FSymplMovementSnapshot.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+FArchive& operator<<(FArchive& Ar, FSymplMovementSnapshotState& State)
+{
+	Ar << State.RuntimeState;
+	State.ModeStack.Serialize(Ar);
+	Ar << State.DashCharges << State.BlinkCharges << State.RollCharges;
+	Ar << State.LastCharacterMovementMode << State.LastBrakingFriction << State.LastMaxAcceleration;
+	return Ar;
+}
+
+void FSymplMovementSnapshotState::ShiftTime(double Delta)
+{
+	//Negative start times mean the ability isn't running.
+	for (double* startTime : { &RuntimeState.ClimbStartTime, &RuntimeState.RollStartTime, &RuntimeState.DashStartTime, &RuntimeState.BlinkStartTime, &RuntimeState.SlideStartTime, &RuntimeState.HoverStartTime })
+	{
+		if (*startTime >= 0.f)
+		{
+			*startTime += Delta;
+		}
+	}
+	for (FSymplResourceMeter* meter : { &RuntimeState.JetpackFuel, &RuntimeState.SprintStamina, &DashCharges, &BlinkCharges, &RollCharges })
+	{
+		meter->BaseTime += Delta;
+	}
+}
+
+void FSymplMovementSnapshot::Write(const FSymplMovementSnapshotState& State, double Time)
+{
+	//Keeps the buffer, so only the first write allocates.
+	Data.Reset(MaxSize);
+	FMemoryWriter writer(Data);
+	uint8 version = Version;
+	writer << version << Time;
+	//Writing doesn't change the state.
+	writer << const_cast<FSymplMovementSnapshotState&>(State);
+	ensureMsgf(Data.Num() <= MaxSize, TEXT("Movement snapshot is %d bytes, raise FSymplMovementSnapshot::MaxSize."), Data.Num());
+}
+
+bool FSymplMovementSnapshot::Read(FSymplMovementSnapshotState& State, double& OutTime) const
+{
+	if (IsEmpty())
+	{
+		return false;
+	}
+	FMemoryReader reader(Data);
+	uint8 version = 0;
+	reader << version;
+	if (version != Version)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Movement snapshot version %u doesn't match %u."), version, Version);
+		return false;
+	}
+	reader << OutTime << State;
+	if (reader.IsError() || !reader.AtEnd())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Movement snapshot is corrupt."));
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FSymplMovementTuning.h"
+
+FName FSymplMovementTuning::GetPerSecondName(FName PerFrameName)
+{
+	if (PerFrameName == GET_MEMBER_NAME_CHECKED(FSymplMovementTuning, JetpackForce))
+	{
+		return GET_MEMBER_NAME_CHECKED(FSymplMovementTuning, JetpackAcceleration);
+	}
+	if (PerFrameName == GET_MEMBER_NAME_CHECKED(FSymplMovementTuning, JetpackDrainRate))
+	{
+		return GET_MEMBER_NAME_CHECKED(FSymplMovementTuning, JetpackDrainPerSecond);
+	}
+	if (PerFrameName == GET_MEMBER_NAME_CHECKED(FSymplMovementTuning, JetpackRefuelRate))
+	{
+		return GET_MEMBER_NAME_CHECKED(FSymplMovementTuning, JetpackRefuelPerSecond);
+	}
+	return NAME_None;
+}
+
+void FSymplMovementTuning::PostSerialize(const FArchive& Ar)
+{
+	if (!Ar.IsLoading())
+	{
+		return;
+	}
+	if (JetpackForce >= 0.f)
+	{
+		JetpackAcceleration = JetpackForce * PerFrameToPerSecond;
+		JetpackForce = -1.f;
+	}
+	if (JetpackDrainRate >= 0.f)
+	{
+		JetpackDrainPerSecond = JetpackDrainRate * PerFrameToPerSecond;
+		JetpackDrainRate = -1.f;
+	}
+	if (JetpackRefuelRate >= 0.f)
+	{
+		JetpackRefuelPerSecond = JetpackRefuelRate * PerFrameToPerSecond;
+		JetpackRefuelRate = -1.f;
+	}
+}
+
+bool FSymplMovementTuningOverride::Apply(FSymplMovementTuning& Tuning) const
+{
+	//Overrides saved or set before the per second properties are per frame.
+	FName name = Property;
+	double newValue = Value;
+	const FName perSecondName = FSymplMovementTuning::GetPerSecondName(Property);
+	if (!perSecondName.IsNone())
+	{
+		name = perSecondName;
+		newValue *= FSymplMovementTuning::PerFrameToPerSecond;
+	}
+	FProperty* property = FSymplMovementTuning::StaticStruct()->FindPropertyByName(name);
+	if (!property)
+	{
+		return false;
+	}
+	void* value = property->ContainerPtrToValuePtr<void>(&Tuning);
+	if (FDoubleProperty* doubleProperty = CastField<FDoubleProperty>(property))
+	{
+		doubleProperty->SetPropertyValue(value, newValue);
+		return true;
+	}
+	if (FFloatProperty* floatProperty = CastField<FFloatProperty>(property))
+	{
+		floatProperty->SetPropertyValue(value, (float)newValue);
+		return true;
+	}
+	if (FIntProperty* intProperty = CastField<FIntProperty>(property))
+	{
+		intProperty->SetPropertyValue(value, FMath::RoundToInt(newValue));
+		return true;
+	}
+	if (FBoolProperty* boolProperty = CastField<FBoolProperty>(property))
+	{
+		boolProperty->SetPropertyValue(value, newValue != 0.f);
+		return true;
+	}
+	return false;
+}
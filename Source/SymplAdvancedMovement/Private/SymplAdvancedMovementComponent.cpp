@@ -8,9 +8,107 @@
 #include "Components/PrimitiveComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/GameStateBase.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Engine/AssetManager.h"
+#include "SignificanceManager.h"
+#include "Engine/NetConnection.h"
+#include "Engine/ActorChannel.h"
+#include "Engine/DemoNetDriver.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "UObject/UObjectIterator.h"
+
+#include "SymplAdvancedMovementSettings.h"
+#include "SymplMovementCounters.h"
+#include "SymplMovementStats.h"
 
 #include "SymplAdvancedMovementInterface.h"
 
+CSV_DEFINE_CATEGORY(SymplMovementNet, true);
+
+static TAutoConsoleVariable<int32> CVarSymplNetStats(
+	TEXT("Sympl.NetStats"),
+	0,
+	TEXT("1 = collect per rpc and per replicated property network stats for advanced movement components on the server."));
+
+namespace SymplMovementNetStats
+{
+	//The rpc function an ESymplMovementRpc counts. The climb checks share one entry.
+	static FName GetRpcFunctionName(ESymplMovementRpc Rpc)
+	{
+		switch (Rpc)
+		{
+		case ESymplMovementRpc::EUPDATETRANSFORM: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_UpdateTransform);
+		case ESymplMovementRpc::ESETJETPACKFUEL: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_SetJetpackFuel);
+		case ESymplMovementRpc::ESETZEROG: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_SetZeroGMovement);
+		case ESymplMovementRpc::ESETJETPACK: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_SetJetpack);
+		case ESymplMovementRpc::ESETINPUT: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_SetForwardInput);
+		case ESymplMovementRpc::EDEPLOYPARACHUTE: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_DeployParachute);
+		case ESymplMovementRpc::ERELEASEPARACHUTE: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_ReleaseParachute);
+		case ESymplMovementRpc::ESETPRONE: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_SetProne);
+		case ESymplMovementRpc::ESETHOVERING: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_SetHovering);
+		case ESymplMovementRpc::ESETMOVEMENTMODE: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_SetMovementMode);
+		case ESymplMovementRpc::ESETMOVEMENTSPEEDS: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_SetMovementSpeeds);
+		case ESymplMovementRpc::EDOCLIMB: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_DoClimb);
+		case ESymplMovementRpc::EADVANCEDJUMP: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_AdvancedJump);
+		case ESymplMovementRpc::ELANDED: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_Landed);
+		case ESymplMovementRpc::EINITIALIZE: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_Initialize);
+		case ESymplMovementRpc::ESETAUTORUN: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_SetAutoRunEnabled);
+		case ESymplMovementRpc::ECLIMBCHECK: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_FrontCheck_Climb);
+		case ESymplMovementRpc::EADVANCEDCROUCH: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_AdvancedCrouch);
+		case ESymplMovementRpc::ESPRINT: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_Sprint);
+		case ESymplMovementRpc::EDASH: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_Dash);
+		case ESymplMovementRpc::EBLINK: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_Blink);
+		case ESymplMovementRpc::EROLL: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_Roll);
+		case ESymplMovementRpc::EPLAYMONTAGE: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_PlayMontage);
+		case ESymplMovementRpc::EREWINDTRAJECTORY: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Server_RewindTrajectory);
+		case ESymplMovementRpc::EPLAYMONTAGEMULTICAST: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Multicast_PlayMontage);
+		case ESymplMovementRpc::ECLIENTJUMP: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Client_Jump);
+		case ESymplMovementRpc::ECLIENTCROUCH: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Client_Crouch);
+		case ESymplMovementRpc::ECORRECTMOVEMENT: return GET_FUNCTION_NAME_CHECKED(USymplAdvancedMovementComponent, Client_CorrectMovement);
+		default: return NAME_None;
+		}
+	}
+
+	//Log the net stats of every component in World.
+	static void Dump(UWorld* World)
+	{
+		if (!USymplAdvancedMovementComponent::IsNetStatsEnabled())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Sympl.NetStats is 0, set it to 1 to collect net stats."));
+		}
+		for (TObjectIterator<USymplAdvancedMovementComponent> it; it; ++it)
+		{
+			if (it->GetWorld() != World || it->GetOwnerRole() != ROLE_Authority)
+			{
+				continue;
+			}
+			const FSymplMovementNetStats stats = it->GetNetStats();
+			UE_LOG(LogTemp, Display, TEXT("%s: %.0f rpc bytes/s, %.0f property bytes/s"), *GetNameSafe(it->GetOwner()), stats.RpcBytesPerSecond, stats.PropertyBytesPerSecond);
+			for (const FSymplRpcNetStats& rpc : stats.Rpcs)
+			{
+				UE_LOG(LogTemp, Display, TEXT("  %s: %d calls, %.1f/s, %lld bytes, %.0f bytes/s%s"), *GetRpcFunctionName(rpc.Rpc).ToString(), rpc.Calls, rpc.CallsPerSecond, rpc.Bytes, rpc.BytesPerSecond,
+					rpc.bReliable ? *FString::Printf(TEXT(", reliable buffer %.0f%%"), rpc.ReliableBufferPressure * 100.f) : TEXT(""));
+			}
+			for (const FSymplPropertyNetStats& property : stats.Properties)
+			{
+				if (property.Changes > 0)
+				{
+					UE_LOG(LogTemp, Display, TEXT("  %s: %d changes, %.1f/s, %lld bytes, %.0f bytes/s"), *property.Property.ToString(), property.Changes, property.ChangesPerSecond, property.Bytes, property.BytesPerSecond);
+				}
+			}
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorld GSymplNetStatsDumpCommand(
+	TEXT("Sympl.NetStats.Dump"),
+	TEXT("Log per rpc and per replicated property network stats for every advanced movement component on the server."),
+	FConsoleCommandWithWorldDelegate::CreateStatic(&SymplMovementNetStats::Dump));
+
 // Sets default values for this component's properties
 USymplAdvancedMovementComponent::USymplAdvancedMovementComponent()
 {
@@ -24,17 +122,15 @@ USymplAdvancedMovementComponent::USymplAdvancedMovementComponent()
 	LeftWallDetect = nullptr;
 	SpeedTable = nullptr;
 	AnimationRow = FDataTableRowHandle();
+	bWarmUpAnimations = false;
 	WallDetectCollisionChannel = ECollisionChannel::ECC_Visibility;
 	SlopeTraceChannel = ECollisionChannel::ECC_Visibility;
 	FloorTraceChannel = ECollisionChannel::ECC_Visibility;
 	SelectedSpeeds.Empty();
 	CurrentMovementAnimations = FSymplMovementAnimations();
 	CurrentMovementSpeed = FSymplMovementSpeeds();
-	CurrentMovementType = EMovementAnimType::ENONE;
 	DefaultMovementMode = EAdvancedMovementMode::EWALK;
 	LastCharacterMovementMode = EMovementMode::MOVE_Walking;
-	bInitialized = false;
-	bDidJump = false;
 	bAllowDoubleJump = true;
 	bManageCustomSpeed = true;
 	bAutoInit = true;
@@ -45,16 +141,16 @@ USymplAdvancedMovementComponent::USymplAdvancedMovementComponent()
 	bCanSlide = true;
 	bIgnoreSlideAngle = true;
 	bOrientRotationToMovement = false; 
-	bIsParachuting = false;
+	PendingMovementMode = EAdvancedMovementMode::ENONE;
+	PendingLastMovementMode = EAdvancedMovementMode::ENONE;
+	bHasPendingMovementMode = false;
+	bHasPendingLastMovementMode = false;
 	bToggleCrouch = false;
 	bToggleSlide = false;
 	bEnableHover = true;
 	bToggleWallRun_Climb = false;
-	bCrouching = false;
-	bSprinting = false;
 	bToggleSprint = false;
 	bForceCustomSlopeTrace = false;
-	bProne = false;
 	bToggleProne = true;
 	bToggleDash = true;
 	bToggleBlink= true;
@@ -62,41 +158,12 @@ USymplAdvancedMovementComponent::USymplAdvancedMovementComponent()
 	bToggleHover = false;
 	bAdjustSpeedToSlope = true;
 	bRestoreJetpackFuelWhenInactive = true;
-	DoubleJumpCounter = 0;
-	AllowedNumberOfDoubleJumps = 0;
-	ClimbTime = 0.f;
-	RollTime = 0.f;
-	DashTime = 0.f;
-	HoverTime = 0.f;
-	RequiredDistanceToDeployParachute = 10000.f;
-	WallDetectTraceRadius = 15.f;
-	MaxWallRun_ClimbTime = 10.f;
-	MaxSlideTime = 10.f;
-	RequiredSlideSpeed = 800.f;
-	RequiredSlideAngle = 30.f;
-	SlideForce = 600.f;
-	SprintSpeed = 800.f;
-	WallRun_ClimbLaunchVelocityScalar = 600.f;
-	CurrentSpeed = 0.f; 
-	MaxBlinkTime = 3.f;
-	MaxDashTime = 3.f;
-	MaxRollTime = 1.f;
-	MaxHoverTime = 10.f;
-	SlideBrakingFriction = 0.f;
-	CurrentSlopeSpeedScalar = 1.f;
-	CurrentSlopeAngle = 0.f; 
-	ParachuteMaxAcceleration = 2500.f;
-	FloorCheckDistance = 100000.f;
 	LastMaxAcceleration = 0.f;
-	MaxJetpackFuel = 100.f;
-	JetpackForce = 10000.f;
-	CurrentJetpackFuel = MaxJetpackFuel;
-	JetpackDrainRate = 1.f;
-	JetpackRefuelRate = .5f;
-	RequiredFuelForJetpack = .1f;
-	DashForce = 1500.f;
-	BlinkForce = 1500.f;
-	RollForce = 500.f;
+	MovementConfig = nullptr;
+	ActiveTuning = nullptr;
+	const FSymplMovementTuning tuning;
+	RuntimeState.JetpackFuel = FSymplResourceMeter(tuning.MaxJetpackFuel, tuning.MaxJetpackFuel);
+	RuntimeState.SprintStamina = FSymplResourceMeter(tuning.MaxSprintStamina, tuning.MaxSprintStamina);
 	ParachuteAttachSocket = "ParachuteSocket";
 	FrontWallCheckTag = "FrontWallCheck";
 	RightWallCheckTag = "RightWallCheck";
@@ -105,111 +172,446 @@ USymplAdvancedMovementComponent::USymplAdvancedMovementComponent()
 	DefaultMeshLocation = FVector(0.f, 0.f, -98.f);
 	DoubleJumpVelocity = FVector(0.f,0.f,500.f);
 	CustomJumpVelocity = FVector(0.f, 0.f, 500.f);
+	TrajectoryCapacity = 128;
+	TrajectoryRecordInterval = .1f;
+	LastTrajectoryRecordTime = -1.f;
 	LastGroundLocation = FVector();
 	LastAirLocation = FVector();
+	bUseSignificance = true;
+	SignificanceTag = "SymplAdvancedMovement";
+	SignificanceMaxDistance = 10000.f;
+	SignificanceMinScreenSize = .005f;
+	NotRenderedSignificanceScalar = .1f;
+	LowSignificanceThreshold = .25f;
+	LowSignificanceTickInterval = .2f;
+	ReplayKeyframeInterval = 1.f;
+	ReplayFullKeyframeInterval = 30;
+	ReplayPlaybackStartTime = 0.f;
+	bFixedTickSimulation = false;
+	FixedTickRate = 60;
+	MaxFixedTicksPerFrame = 4;
+	RollbackFrames = 16;
+	//Defaults the deprecated tuning is migrated against. These are the values the properties had before they moved.
+	AllowedNumberOfDoubleJumps = 0;
+	WallDetectTraceRadius = 15.f;
+	RequiredSlideAngle = 30.f;
+	MaxJetpackFuel = 100.f;
+	JetpackForce = 10000.f;
+	RequiredFuelForJetpack = .1f;
+	JetpackDrainRate = 1.f;
+	JetpackRefuelRate = .5f;
+	MaxWallRun_ClimbTime = 10.f;
+	MaxBlinkTime = 3.f;
+	MaxBlinkCharges = 1;
+	BlinkChargeCooldown = 0.f;
+	SlideBrakingFriction = 0.f;
+	MaxDashTime = 3.f;
+	MaxDashCharges = 1;
+	DashChargeCooldown = 0.f;
+	MaxHoverTime = 10.f;
+	MaxRollTime = 1.f;
+	MaxRollCharges = 1;
+	RollChargeCooldown = 0.f;
+	MaxSlideTime = 10.f;
+	SlideForce = 600.f;
+	SprintSpeed = 800.f;
+	bUseSprintStamina = false;
+	MaxSprintStamina = 100.f;
+	SprintStaminaDrainRate = 20.f;
+	SprintStaminaRegenRate = 10.f;
+	WallRun_ClimbLaunchVelocityScalar = 600.f;
+	RequiredSlideSpeed = 800.f;
+	ParachuteMaxAcceleration = 2500.f;
+	RequiredDistanceToDeployParachute = 10000.f;
+	FloorCheckDistance = 100000.f;
+	BlinkForce = 1500.f;
+	DashForce = 1500.f;
+	RollForce = 500.f;
+	MaxSimSubstepTime = 0.f;
+	MaxSimSubsteps = 4;
+	SimFrame = 0;
+	FixedTickAccumulator = 0.f;
+	SimStepFrameFraction = 1.f;
+	LastSimTime = -1.f;
+	AnimSnapshotSequence = 0;
+	bRegisteredSignificance = false;
+	bLowSignificance = false;
+	CurrentSignificance = 1.f;
+	DefaultTickInterval = 0.f;
+	TickLODInterval = 0.f;
+	LastTickLODUpdateTime = -1.f;
+	InternalCallDepth = 0;
+	RollbackDepth = 0;
 }
 
 // Called when the game starts
 void USymplAdvancedMovementComponent::BeginPlay()
 {
 	Super::BeginPlay();
+	//Picks up deprecated tuning set by construction scripts.
+	MigrateDeprecatedTuning();
+	ApplyMovementConfig();
+	if (bFixedTickSimulation)
+	{
+		RollbackBuffer.Init(RollbackFrames);
+	}
+
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		//Allocate the trajectory history once.
+		TrajectoryHistory.Init(TrajectoryCapacity);
+		//Start full, using this instance's tuning.
+		const double time = GetServerWorldTime();
+		RuntimeState.JetpackFuel = FSymplResourceMeter(GetTuning().MaxJetpackFuel, GetTuning().MaxJetpackFuel);
+		RuntimeState.JetpackFuel.BaseTime = time;
+		RuntimeState.SprintStamina = FSymplResourceMeter(GetTuning().MaxSprintStamina, GetTuning().MaxSprintStamina);
+		RuntimeState.SprintStamina.BaseTime = time;
+		DashCharges = MakeAbilityCharges(GetTuning().MaxDashCharges, GetTuning().DashChargeCooldown, time);
+		BlinkCharges = MakeAbilityCharges(GetTuning().MaxBlinkCharges, GetTuning().BlinkChargeCooldown, time);
+		RollCharges = MakeAbilityCharges(GetTuning().MaxRollCharges, GetTuning().RollChargeCooldown, time);
+	}
 
 	if (bAutoInit)
 	{
 		//Handle auto init.
 		Server_Initialize();
 	}
+
+	//Server_Initialize doesn't run on remote clients, but they still play the multicast montages.
+	if (bWarmUpAnimations && GetOwnerRole() < ROLE_Authority && AnimationRow.DataTable)
+	{
+		if (FSymplMovementAnimations* anims = AnimationRow.DataTable->FindRow<FSymplMovementAnimations>(AnimationRow.RowName, ""))
+		{
+			WarmUpAnimations(*anims);
+		}
+	}
+
+	DefaultTickInterval = GetComponentTickInterval();
+	//Only rate remote owners, our own pawn is always significant.
+	APawn* pawn = Cast<APawn>(GetOwner());
+	if (bUseSignificance && GetNetMode() != NM_DedicatedServer && !(pawn && pawn->IsLocallyControlled()))
+	{
+		if (USignificanceManager* manager = USignificanceManager::Get(GetWorld()))
+		{
+			manager->RegisterObject(this, SignificanceTag,
+				[](USignificanceManager::FManagedObjectInfo* Info, const FTransform& Viewpoint)
+				{
+					return CastChecked<USymplAdvancedMovementComponent>(Info->GetObject())->CalculateSignificance(Viewpoint);
+				},
+				USignificanceManager::EPostSignificanceType::Sequential,
+				[](USignificanceManager::FManagedObjectInfo* Info, float OldSignificance, float Significance, bool bFinal)
+				{
+					CastChecked<USymplAdvancedMovementComponent>(Info->GetObject())->SetSignificance(Significance);
+				});
+			bRegisteredSignificance = true;
+		}
+	}
+}
+
+void USymplAdvancedMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bRegisteredSignificance)
+	{
+		if (USignificanceManager* manager = USignificanceManager::Get(GetWorld()))
+		{
+			manager->UnregisterObject(this);
+		}
+		bRegisteredSignificance = false;
+	}
+	ResetNetStats();
+	UnbindMovementConfig();
+	StopReplayRecording();
+	StopReplayPlayback();
+	if (AnimationWarmUpHandle.IsValid())
+	{
+		AnimationWarmUpHandle->ReleaseHandle();
+		AnimationWarmUpHandle.Reset();
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+void USymplAdvancedMovementComponent::PostLoad()
+{
+	Super::PostLoad();
+	MigrateDeprecatedTuning();
+}
+
+void USymplAdvancedMovementComponent::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	//Count our own heap allocations.
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(TrajectoryHistory.GetAllocatedSize());
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(RollbackBuffer.GetAllocatedSize());
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(SelectedSpeeds.GetAllocatedSize());
+}
+
+float USymplAdvancedMovementComponent::CalculateSignificance(const FTransform& Viewpoint) const
+{
+	const AActor* owner = GetOwner();
+	if (!owner || SignificanceMaxDistance <= 0.f)
+	{
+		return 1.f;
+	}
+	//Distance.
+	const double distance = FVector::Dist(owner->GetActorLocation(), Viewpoint.GetLocation());
+	if (distance >= SignificanceMaxDistance)
+	{
+		return 0.f;
+	}
+	//Screen size.
+	const double radius = owner->GetRootComponent() ? owner->GetRootComponent()->Bounds.SphereRadius : 0.f;
+	if (radius / FMath::Max(distance, 1.0) < SignificanceMinScreenSize)
+	{
+		return 0.f;
+	}
+	//Visibility.
+	double significance = 1.0 - (distance / SignificanceMaxDistance);
+	if (!owner->WasRecentlyRendered(.2f))
+	{
+		significance *= NotRenderedSignificanceScalar;
+	}
+	return (float)significance;
+}
+
+void USymplAdvancedMovementComponent::SetSignificance(float Significance)
+{
+	CurrentSignificance = Significance;
+	const bool low = Significance < LowSignificanceThreshold;
+	//The parachute can replicate in after significance changed, so check it every time.
+	if (ParachuteActor && ParachuteActor->IsHidden() != low)
+	{
+		ParachuteActor->SetActorHiddenInGame(low);
+		ParachuteActor->SetActorTickEnabled(!low);
+	}
+	if (low == bLowSignificance)
+	{
+		return;
+	}
+	bLowSignificance = low;
+	UpdateTickInterval();
+}
+
+void USymplAdvancedMovementComponent::UpdateTickLOD()
+{
+	SYMPL_SCOPE(UpdateTickLOD);
+	const USymplAdvancedMovementSettings* settings = GetDefault<USymplAdvancedMovementSettings>();
+	const double time = GetWorld()->GetTimeSeconds();
+	if (LastTickLODUpdateTime >= 0.f && time - LastTickLODUpdateTime < settings->TickLODUpdateInterval)
+	{
+		return;
+	}
+	LastTickLODUpdateTime = time;
+	if (!settings->bEnableTickLOD)
+	{
+		TickLODInterval = 0.f;
+		UpdateTickInterval();
+		return;
+	}
+	//Authority and the local player always get their own rate.
+	const ENetRole role = GetOwnerRole();
+	if (role == ROLE_Authority)
+	{
+		TickLODInterval = settings->AuthorityTickInterval;
+	}
+	else if (role == ROLE_AutonomousProxy)
+	{
+		TickLODInterval = settings->AutonomousProxyTickInterval;
+	}
+	else
+	{
+		TickLODInterval = settings->SimulatedProxyTickInterval;
+		if (!GetOwner()->WasRecentlyRendered(.2f))
+		{
+			TickLODInterval = FMath::Max(TickLODInterval, settings->OffscreenTickInterval);
+		}
+		else if (APlayerController* controller = GetWorld()->GetFirstPlayerController())
+		{
+			//Scale between near and far distance.
+			FVector viewLocation;
+			FRotator viewRotation;
+			controller->GetPlayerViewPoint(viewLocation, viewRotation);
+			const double distance = FVector::Dist(viewLocation, GetOwner()->GetActorLocation());
+			const double alpha = FMath::GetRangePct((double)settings->NearDistance, (double)FMath::Max(settings->FarDistance, settings->NearDistance + 1.f), distance);
+			TickLODInterval = FMath::Lerp(TickLODInterval, FMath::Max(TickLODInterval, settings->FarTickInterval), FMath::Clamp(alpha, 0.0, 1.0));
+		}
+	}
+	UpdateTickInterval();
+}
+
+void USymplAdvancedMovementComponent::UpdateTickInterval()
+{
+	float interval = FMath::Max(DefaultTickInterval, TickLODInterval);
+	if (bLowSignificance)
+	{
+		interval = FMath::Max(interval, LowSignificanceTickInterval);
+	}
+	//No point ticking more often than we simulate.
+	if (IsServerFixedRate())
+	{
+		interval = FMath::Max(interval, 1.f / GetDefault<USymplAdvancedMovementSettings>()->ServerSimulationRate);
+	}
+	if (!FMath::IsNearlyEqual(interval, GetComponentTickInterval()))
+	{
+		SetComponentTickInterval(interval);
+	}
+}
+
+bool USymplAdvancedMovementComponent::IsCosmeticOnlyTick() const
+{
+	return GetOwnerRole() == ROLE_SimulatedProxy && GetDefault<USymplAdvancedMovementSettings>()->bSimulatedProxyCosmeticOnly;
+}
+
+bool USymplAdvancedMovementComponent::IsClientServerRpc() const
+{
+	if (InternalCallDepth > 0 || GetOwnerRole() != ROLE_Authority || GetNetMode() == NM_Standalone)
+	{
+		return false;
+	}
+	//The host's own pawn and AI are controlled here.
+	if (OwnerAsPawn && OwnerAsPawn->IsLocallyControlled())
+	{
+		return false;
+	}
+	//Only actors owned by a remote player have a connection on the server.
+	return GetOwner() && GetOwner()->GetNetConnection() != nullptr;
+}
+
+bool USymplAdvancedMovementComponent::AcceptServerRpc(ESymplMovementRpc Rpc)
+{
+	SYMPL_COUNT(ServerRpcs, 1);
+	if (!IsClientServerRpc())
+	{
+		return true;
+	}
+	RecordRpc(Rpc);
+	const USymplAdvancedMovementSettings* settings = GetDefault<USymplAdvancedMovementSettings>();
+	if (!settings->bEnableRpcRateLimiting)
+	{
+		return true;
+	}
+	return RpcRateLimiter.TryConsume(Rpc, GetWorld()->GetTimeSeconds(), settings->GetRpcRateLimit(Rpc));
+}
+
+void USymplAdvancedMovementComponent::RejectServerRpc(ESymplMovementRpc Rpc)
+{
+	RpcRateLimiter.AddRejected(Rpc);
+}
+
+bool USymplAdvancedMovementComponent::RewoundSweep(double ClientTime, FVector Offset, double Radius, FHitResult& OutHit) const
+{
+	//Rewind to where the owner was when the client acted.
+	const double now = GetServerWorldTime();
+	const double time = FMath::Clamp(ClientTime < 0.f ? now : ClientTime, now - GetDefault<USymplAdvancedMovementSettings>()->MaxRewindTime, now);
+	FSymplTrajectorySample sample;
+	const FVector start = TrajectoryHistory.SampleAtTime(time, sample) ? sample.Location : OwnerRef->GetActorLocation();
+	FCollisionQueryParams params;
+	params.AddIgnoredActor(OwnerRef);
+	SYMPL_COUNT(Traces, 1);
+	return GetWorld()->SweepSingleByChannel(OutHit, start, start + Offset, FQuat::Identity, WallDetectCollisionChannel, FCollisionShape::MakeSphere(Radius), params);
+}
+
+bool USymplAdvancedMovementComponent::ValidateClientClimb(EMovementAnimType AnimType, double ClientTime) const
+{
+	const USymplAdvancedMovementSettings* settings = GetDefault<USymplAdvancedMovementSettings>();
+	if (!settings->bEnableRewindValidation || !OwnerRef)
+	{
+		return true;
+	}
+	USceneComponent* wallDetect = AnimType == EMovementAnimType::ECLIMBLEFT ? LeftWallDetect : AnimType == EMovementAnimType::ECLIMBRIGHT ? RightWallDetect : FrontWallDetect;
+	if (!wallDetect)
+	{
+		return true;
+	}
+	//Same sweep as ClimbCheck, but from the rewound location.
+	FHitResult hit;
+	return RewoundSweep(ClientTime, wallDetect->GetComponentLocation() - OwnerRef->GetActorLocation(), GetTuning().WallDetectTraceRadius + settings->RewindTolerance, hit);
+}
+
+bool USymplAdvancedMovementComponent::ValidateClientBlink(FVector Direction, double ClientTime) const
+{
+	const USymplAdvancedMovementSettings* settings = GetDefault<USymplAdvancedMovementSettings>();
+	if (!settings->bEnableRewindValidation || !OwnerRef || Direction.IsNearlyZero())
+	{
+		return true;
+	}
+	//Reject blinks that start inside or right against blocking geometry.
+	FHitResult hit;
+	return !RewoundSweep(ClientTime, Direction.GetSafeNormal() * settings->BlinkProbeDistance, settings->RewindTolerance, hit);
+}
+
+void USymplAdvancedMovementComponent::SendMovementCorrection()
+{
+	if (OwnerRef)
+	{
+		RecordRpc(ESymplMovementRpc::ECORRECTMOVEMENT);
+		Client_CorrectMovement(OwnerRef->GetActorLocation(), RuntimeState.CurrentVelocity, RuntimeState.CurrentMovementMode);
+	}
 }
 
 // Called every frame
 void USymplAdvancedMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	SYMPL_SCOPE(TickComponent);
+	SYMPL_SCOPE_TICK_CYCLES();
+
+	if (ReplayPlayer)
+	{
+		TickReplayPlayback();
+		return;
+	}
+	//Record the state the last frame left us in.
+	if (ReplayRecorder)
+	{
+		FSymplMovementSnapshotState state;
+		GetSnapshotState(state);
+		//Keep the whole track on the replay clock so playback shifts it back in one step.
+		const double replayTime = GetReplayTime();
+		state.ShiftTime(replayTime - GetServerWorldTime());
+		ReplayRecorder->Record(replayTime, state);
+	}
+
+	if (IsNetStatsEnabled() && GetOwnerRole() == ROLE_Authority)
+	{
+		NetStats.Update(GetWorld()->GetTimeSeconds());
+	}
+
+	//Server rpcs we call from here are not rate limited.
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
+
+	UpdateTickLOD();
+	//Simulated proxies get their state from the server, so they only need the cosmetic regions.
+	const bool bCosmeticOnly = IsCosmeticOnlyTick();
 
 	if (IsInitialized())
 	{
 		if (OwnerAsPawn)
 		{
-			CurrentVelocity = OwnerAsPawn->GetMovementComponent()->Velocity;
+			RuntimeState.CurrentVelocity = OwnerAsPawn->GetMovementComponent()->Velocity;
 		}
 		else
 		{
-			OwnerRef->GetVelocity();
-		}
-#pragma region SLOPECALCULATIONS
-		if (bAdjustSpeedToSlope && SlopeSpeedCurve)
-		{
-			if (OwnerAsChar && !bForceCustomSlopeTrace)
-			{
-				//Get the slope angle from the find floor result.
-				CurrentSlopeAngle = FMath::RadiansToDegrees(FMath::Acos(OwnerAsChar->GetCharacterMovement()->CurrentFloor.HitResult.ImpactNormal.Z));
-			}
-			else
-			{
-				//Trace for slope
-				FVector up = OwnerRef->GetActorUpVector();
-				FVector down = up * -1.0f;
-
-				FHitResult hit;
-				FCollisionQueryParams params;
-				FCollisionResponseParams response;
-				FCollisionShape shape;
-				shape.MakeSphere(1.f);
-				params.bFindInitialOverlaps = true;
-
-				if (GetWorld()->SweepSingleByChannel(hit, OwnerRef->GetActorLocation(), OwnerRef->GetActorLocation() + down * 100.0f, FQuat(), SlopeTraceChannel, shape, params, response))
-				{
-					CurrentSlopeAngle = FMath::RadiansToDegrees(FMath::Acos(hit.ImpactNormal | up));
-				}
-				else
-				{
-					//No hit so we assume we are on an even plane.
-					CurrentSlopeAngle = 0.f;
-				}
-			}
-			//Gather the value from the Curvedouble.
-			CurrentSlopeSpeedScalar = SlopeSpeedCurve->GetFloatValue(CurrentSlopeAngle);
+			RuntimeState.CurrentVelocity = OwnerRef->GetVelocity();
 		}
 
-#pragma endregion
-
-#pragma region SPEED
-		if (bManageCustomSpeed)
+		if (bCosmeticOnly)
 		{
-			if (SelectedSpeeds.Num() > 0 && CurrentMovementMode != LastMovementMode)
+			//Keep the speed in sync with the replicated movement mode.
+			double speed = 0.f;
+			if (bManageCustomSpeed && RuntimeState.CurrentMovementMode != RuntimeState.LastMovementMode && QueryModeSpeed(RuntimeState.CurrentMovementMode, speed))
 			{
-				for (auto& speed : SelectedSpeeds)
-				{
-					if (speed.MovementMode == CurrentMovementMode)
-					{
-						CurrentSpeed = speed.Speed * CurrentSlopeSpeedScalar;
-						if (OwnerAsChar)
-						{
-							if (CurrentMovementMode == EAdvancedMovementMode::EFLY)
-							{
-								OwnerAsChar->GetCharacterMovement()->MaxFlySpeed = CurrentSpeed;
-							}
-							else if (CurrentMovementMode == EAdvancedMovementMode::ECROUCH)
-							{
-
-								OwnerAsChar->GetCharacterMovement()->MaxWalkSpeedCrouched = CurrentSpeed;
-							}
-							else
-							{
-								OwnerAsChar->GetCharacterMovement()->MaxWalkSpeed = CurrentSpeed;
-							}
-						}
-					}
-					break;
-				}
+				RuntimeState.CurrentSpeed = speed * RuntimeState.CurrentSlopeSpeedScalar;
+				ApplyCharacterSpeed();
 			}
+			PublishAnimSnapshot();
+			return;
 		}
-#pragma endregion
 
 #pragma region AUTORUN
 		//Handle auto run
 		if (IsAutoRunEnabled())
 		{
+			SYMPL_SCOPE(AutoRun);
 			if (OwnerAsPawn && OwnerRef->GetClass()->ImplementsInterface(USymplAdvancedMovementInterface::StaticClass()))
 			{
 				//Add pawn movement input to our forward vector if auto run is enabled.
@@ -220,15 +622,16 @@ void USymplAdvancedMovementComponent::TickComponent(float DeltaTime, ELevelTick
 				if (OwnerRef && OwnerRef->GetClass()->ImplementsInterface(USymplAdvancedMovementInterface::StaticClass()))
 				{
 					//Add local offset for actors that aren't pawns or characters..
-					OwnerRef->AddActorLocalOffset(OwnerRef->GetActorForwardVector() * ISymplAdvancedMovementInterface::Execute_GetOwnerSpeed(OwnerRef));
+					OwnerRef->AddActorLocalOffset(OwnerRef->GetActorForwardVector() * ISymplAdvancedMovementInterface::Execute_GetOwnerSpeed(OwnerRef) * GetTuning().OffsetMoveRate * DeltaTime);
 				}
 			}
 		}
 #pragma endregion
 
 #pragma region CLIMBING
-		if (bEnableClimbing_WallRun && bDidJump)
+		if (bEnableClimbing_WallRun && RuntimeState.bDidJump)
 		{
+			SYMPL_SCOPE(Climbing);
 			bool climb = false;
 			if (OwnerAsPawn)
 			{
@@ -239,204 +642,993 @@ void USymplAdvancedMovementComponent::TickComponent(float DeltaTime, ELevelTick
 				//Disable climbing animation type.
 				if (!FrontClimbCheck(DeltaTime) && !RightClimbCheck(DeltaTime) && !LeftClimbCheck(DeltaTime))
 				{
-					CurrentMovementType = EMovementAnimType::ENONE;
+					RuntimeState.CurrentMovementType = EMovementAnimType::ENONE;
 				}
 			}
 		}
 #pragma endregion
 
-#pragma region SLIDING
-		//Slide on server only.
-		if (GetOwner()->GetLocalRole() >= ROLE_Authority)
+#pragma region SIMULATION
+		//Slope, speed, sliding, abilities, zero g and the jetpack are stepped by the simulation core.
+		const double step = GetFixedStepTime();
+		if (step > 0.f)
 		{
-			if (bCanSlide)
+			FixedTickAccumulator += DeltaTime;
+			TGuardValue<double> stepFraction(SimStepFrameFraction, DeltaTime > 0.f ? step / DeltaTime : 1.f);
+			int32 ticks = 0;
+			while (FixedTickAccumulator >= step && ticks < MaxFixedTicksPerFrame)
 			{
-				if (CanSlide() && bSliding)
-				{
-					//Increment slide time.
-					SlideTime += DeltaTime;
-					//Set movement anim type.
-					CurrentMovementType = EMovementAnimType::ESLIDING;
-					if (OwnerAsChar)
-					{
-						//Set movement defaults for character.
-						OwnerAsChar->GetCharacterMovement()->bOrientRotationToMovement = false;
-						OwnerAsChar->GetCharacterMovement()->SetMovementMode(MOVE_Falling);
-					}
-					//Set slide direction and add force.
-					FVector dir = OwnerRef->GetActorForwardVector();
-					dir.Normalize();
-					if (OwnerAsChar)
-					{
-						OwnerAsChar->GetCharacterMovement()->BrakingFriction = SlideBrakingFriction;
-						OwnerAsChar->GetCharacterMovement()->AddForce(dir * SlideForce);
-					}
-					else
-					{
-						OwnerRef->AddActorLocalOffset(dir * SlideForce);
-					}
-				}
+				FixedTickAccumulator -= step;
+				FSymplMovementSimInput input = GatherSimInput();
+				//The time the step ends at, not the time of the frame.
+				input.Time -= FixedTickAccumulator;
+				StepFixedTick(input, step);
+				ticks++;
 			}
-			else
+			FixedTickAccumulator = FMath::Min(FixedTickAccumulator, step);
+		}
+		else
+		{
+			//Split long frames so a low tick rate steps the same as a high one.
+			const int32 substeps = MaxSimSubstepTime > 0.f ? FMath::Clamp(FMath::CeilToInt(DeltaTime / MaxSimSubstepTime), 1, FMath::Max(MaxSimSubsteps, 1)) : 1;
+			const double substep = DeltaTime / substeps;
+			TGuardValue<double> stepFraction(SimStepFrameFraction, 1.f / substeps);
+			for (int32 i = 0; i < substeps; i++)
 			{
-				//Reset sliding.
-				CurrentMovementType = EMovementAnimType::ENONE;
-				if (OwnerAsChar)
-				{
-					OwnerAsChar->GetCharacterMovement()->BrakingFriction = LastBrakingFriction;
-					OwnerAsChar->GetCharacterMovement()->bOrientRotationToMovement = bOrientRotationToMovement;
-					OwnerAsChar->GetCharacterMovement()->SetMovementMode(MOVE_Walking);
-				}
-				SlideTime = 0.f;
+				FSymplMovementSimInput input = GatherSimInput();
+				input.Time -= substep * (substeps - 1 - i);
+				ApplySimResult(SymplMovementSimulation::Step(SimConfig, GatherSimState(), input, substep, *this));
+				SYMPL_COUNT(SimSteps, 1);
 			}
 		}
 #pragma endregion
 
-#pragma region DASHING
-		//Handle dashing.
-		if (bDashing && CanDash())
+	}
+
+#pragma region LOCATIONS
+
+	//Record the trajectory on the server only.
+	if (OwnerRef && GetOwnerRole() == ROLE_Authority)
+	{
+		SYMPL_SCOPE(Locations);
+		const double time = GetServerWorldTime();
+		if (LastTrajectoryRecordTime < 0.f || time - LastTrajectoryRecordTime >= TrajectoryRecordInterval)
 		{
-			if (OwnerAsChar)
+			bool falling = false;
+			if (OwnerRef->GetClass()->ImplementsInterface(USymplAdvancedMovementInterface::StaticClass()))
 			{
-				OwnerAsChar->LaunchCharacter((CurrentDashDirection * DashForce),true,true);
+				falling = ISymplAdvancedMovementInterface::Execute_SymplIsFalling(OwnerRef);
 			}
-			else
+			else if (OwnerAsPawn && OwnerAsPawn->GetMovementComponent())
 			{
-				OwnerRef->AddActorLocalOffset(CurrentDashDirection * CurrentSpeed);
+				falling = OwnerAsPawn->GetMovementComponent()->IsFalling();
 			}
-			DashTime += DeltaTime;
-		}
-		else
-		{
-			DashTime = 0.f;
-			if(bDashing)
-				Server_Dash(false, FVector(), true);
+			TrajectoryHistory.Add(FSymplTrajectorySample(time, OwnerRef->GetActorLocation(), RuntimeState.CurrentVelocity, RuntimeState.CurrentMovementMode, !falling));
+			LastTrajectoryRecordTime = time;
+			//Only changes when a sample is recorded, so it replicates at most at the record interval.
+			(falling ? LastAirLocation : LastGroundLocation) = OwnerRef->GetActorLocation();
 		}
+	}
+
 #pragma endregion
 
-#pragma region BLINKING
-		//Handle blinking.
-		if (bBlinking && CanBlink())
+	CommitMovementMode();
+	PublishAnimSnapshot();
+}
+
+FSymplMovementAnimSnapshot USymplAdvancedMovementComponent::GetAnimSnapshot() const
+{
+	//Copy out the published snapshot, and copy again if the writer got back around to that buffer while we were reading it.
+	for (;;)
+	{
+		const uint32 sequence = AnimSnapshotSequence.load(std::memory_order_acquire);
+		FSymplMovementAnimSnapshot snapshot = AnimSnapshots[(sequence >> 1) & 1];
+		std::atomic_thread_fence(std::memory_order_acquire);
+		//The buffer we read is next written by the publish after the one following it, which first moves the sequence 3 past the even value.
+		if (AnimSnapshotSequence.load(std::memory_order_relaxed) - (sequence & ~1u) < 3)
 		{
-			if (OwnerAsChar)
-			{
-				OwnerAsChar->LaunchCharacter((CurrentBlinkDirection * BlinkForce),true,true);
-			}
-			else
+			return snapshot;
+		}
+	}
+}
+
+void USymplAdvancedMovementComponent::PublishAnimSnapshot()
+{
+	SYMPL_SCOPE(PublishAnimSnapshot);
+	//Write into the buffer readers aren't using, then flip. Only the game thread writes, so the sequence is even here.
+	const uint32 sequence = AnimSnapshotSequence.load(std::memory_order_relaxed);
+	AnimSnapshotSequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	FSymplMovementAnimSnapshot& snapshot = AnimSnapshots[((sequence >> 1) + 1) & 1];
+	snapshot.FrameNumber = (int64)GFrameCounter;
+	snapshot.MovementMode = RuntimeState.CurrentMovementMode;
+	snapshot.LastMovementMode = RuntimeState.LastMovementMode;
+	snapshot.MovementType = RuntimeState.CurrentMovementType;
+	snapshot.bSliding = HasMovementState(ESymplMovementState::Sliding);
+	snapshot.bCrouching = HasMovementState(ESymplMovementState::Crouching);
+	snapshot.bSprinting = HasMovementState(ESymplMovementState::Sprinting);
+	snapshot.bProne = HasMovementState(ESymplMovementState::Prone);
+	snapshot.bDashing = HasMovementState(ESymplMovementState::Dashing);
+	snapshot.bBlinking = HasMovementState(ESymplMovementState::Blinking);
+	snapshot.bRolling = HasMovementState(ESymplMovementState::Rolling);
+	snapshot.bHovering = HasMovementState(ESymplMovementState::Hovering);
+	snapshot.bDidJump = RuntimeState.bDidJump;
+	snapshot.bIsParachuting = HasMovementState(ESymplMovementState::Parachuting);
+	snapshot.bZeroGMovement = HasMovementState(ESymplMovementState::ZeroG);
+	snapshot.bJetpackActive = HasMovementState(ESymplMovementState::Jetpack);
+	snapshot.bAutoRunEnabled = RuntimeState.bAutoRunEnabled;
+	snapshot.Velocity = RuntimeState.CurrentVelocity;
+	snapshot.SlopeAngle = RuntimeState.CurrentSlopeAngle;
+	snapshot.Speed = RuntimeState.CurrentSpeed;
+	snapshot.InputDirection = GetInputDirection();
+	InterpolateSimulatedProxy(snapshot);
+	AnimSnapshotSequence.store(sequence + 2, std::memory_order_release);
+}
+
+FSymplMovementSimState USymplAdvancedMovementComponent::GatherSimState() const
+{
+	FSymplMovementSimState state;
+	state.MovementMode = RuntimeState.CurrentMovementMode;
+	state.LastMovementMode = RuntimeState.LastMovementMode;
+	state.MovementType = RuntimeState.CurrentMovementType;
+	state.Flags = GetMovementState();
+	state.Set(ESymplMovementSimFlags::DidJump, RuntimeState.bDidJump);
+	state.Set(ESymplMovementSimFlags::AutoRun, RuntimeState.bAutoRunEnabled);
+	state.DoubleJumpCounter = RuntimeState.DoubleJumpCounter;
+	state.Velocity = RuntimeState.CurrentVelocity;
+	state.DashDirection = RuntimeState.CurrentDashDirection;
+	state.BlinkDirection = RuntimeState.CurrentBlinkDirection;
+	state.RollDirection = RuntimeState.CurrentRollDirection;
+	state.DashStartTime = RuntimeState.DashStartTime;
+	state.BlinkStartTime = RuntimeState.BlinkStartTime;
+	state.RollStartTime = RuntimeState.RollStartTime;
+	state.HoverStartTime = RuntimeState.HoverStartTime;
+	state.SlideStartTime = RuntimeState.SlideStartTime;
+	state.ClimbStartTime = RuntimeState.ClimbStartTime;
+	state.JetpackFuel = RuntimeState.JetpackFuel;
+	state.SprintStamina = RuntimeState.SprintStamina;
+	state.SlopeAngle = RuntimeState.CurrentSlopeAngle;
+	state.SlopeSpeedScalar = RuntimeState.CurrentSlopeSpeedScalar;
+	state.Speed = RuntimeState.CurrentSpeed;
+	return state;
+}
+
+FSymplMovementSimConfig USymplAdvancedMovementComponent::GatherSimConfig() const
+{
+	FSymplMovementSimConfig config;
+	config.MaxDashTime = GetTuning().MaxDashTime;
+	config.MaxBlinkTime = GetTuning().MaxBlinkTime;
+	config.MaxRollTime = GetTuning().MaxRollTime;
+	config.MaxHoverTime = GetTuning().MaxHoverTime;
+	config.MaxSlideTime = GetTuning().MaxSlideTime;
+	config.DashForce = GetTuning().DashForce;
+	config.BlinkForce = GetTuning().BlinkForce;
+	config.RollForce = GetTuning().RollForce;
+	config.SlideForce = GetTuning().SlideForce;
+	config.OffsetMoveRate = GetTuning().OffsetMoveRate;
+	config.JetpackAcceleration = GetTuning().JetpackAcceleration;
+	config.MaxJetpackFuel = GetTuning().MaxJetpackFuel;
+	config.RequiredFuelForJetpack = GetTuning().RequiredFuelForJetpack;
+	config.JetpackDrainPerSecond = GetTuning().JetpackDrainPerSecond;
+	config.JetpackRefuelPerSecond = GetTuning().JetpackRefuelPerSecond;
+	config.MaxSprintStamina = GetTuning().MaxSprintStamina;
+	config.SprintStaminaDrainRate = GetTuning().SprintStaminaDrainRate;
+	config.SprintStaminaRegenRate = GetTuning().SprintStaminaRegenRate;
+	config.bUseSprintStamina = GetTuning().bUseSprintStamina;
+	config.RequiredSlideSpeed = GetTuning().RequiredSlideSpeed;
+	config.RequiredSlideAngle = GetTuning().RequiredSlideAngle;
+	config.bAdjustSpeedToSlope = bAdjustSpeedToSlope && SlopeSpeedCurve != nullptr;
+	config.bManageCustomSpeed = bManageCustomSpeed;
+	config.bCanSlide = bCanSlide;
+	config.bIgnoreSlideAngle = bIgnoreSlideAngle;
+	config.bEnableHover = bEnableHover;
+	config.bRestoreJetpackFuelWhenInactive = bRestoreJetpackFuelWhenInactive;
+	return config;
+}
+
+void USymplAdvancedMovementComponent::RefreshSimConfig()
+{
+	SimConfig = GatherSimConfig();
+}
+
+void USymplAdvancedMovementComponent::SetMovementConfig(USymplMovementConfig* Config)
+{
+	if (GetOwner() && GetOwnerRole() != ROLE_Authority)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: SetMovementConfig can only be called with authority."), *GetNameSafe(GetOwner()));
+		return;
+	}
+	MovementConfig = Config;
+	ApplyMovementConfig();
+}
+
+bool USymplAdvancedMovementComponent::SetTuningOverride(FName Property, double Value)
+{
+	if (GetOwner() && GetOwnerRole() != ROLE_Authority)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: SetTuningOverride can only be called with authority."), *GetNameSafe(GetOwner()));
+		return false;
+	}
+	//Check the name before storing it.
+	FSymplMovementTuning tuning;
+	if (!FSymplMovementTuningOverride(Property, Value).Apply(tuning))
+	{
+		return false;
+	}
+	FSymplMovementTuningOverride* existing = TuningOverrides.FindByPredicate([Property](const FSymplMovementTuningOverride& Other) { return Other.Property == Property; });
+	if (existing)
+	{
+		existing->Value = Value;
+	}
+	else
+	{
+		TuningOverrides.Emplace(Property, Value);
+	}
+	ApplyMovementConfig();
+	return true;
+}
+
+void USymplAdvancedMovementComponent::RemoveTuningOverride(FName Property)
+{
+	if (GetOwner() && GetOwnerRole() != ROLE_Authority)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: RemoveTuningOverride can only be called with authority."), *GetNameSafe(GetOwner()));
+		return;
+	}
+	if (TuningOverrides.RemoveAll([Property](const FSymplMovementTuningOverride& Other) { return Other.Property == Property; }) > 0)
+	{
+		ApplyMovementConfig();
+	}
+}
+
+void USymplAdvancedMovementComponent::ApplyMovementConfig()
+{
+	USymplMovementConfig* config = MovementConfig ? MovementConfig : GetMutableDefault<USymplMovementConfig>();
+	if (BoundConfig.Get() != config)
+	{
+		UnbindMovementConfig();
+		ConfigChangedHandle = config->OnTuningChanged.AddUObject(this, &USymplAdvancedMovementComponent::OnMovementConfigChanged);
+		BoundConfig = config;
+	}
+	//Without overrides we read the shared tuning directly.
+	if (TuningOverrides.Num() == 0)
+	{
+		OverriddenTuning.Reset();
+		ActiveTuning = &config->Tuning;
+	}
+	else
+	{
+		if (!OverriddenTuning)
+		{
+			OverriddenTuning = MakeUnique<FSymplMovementTuning>();
+		}
+		*OverriddenTuning = config->Tuning;
+		for (const FSymplMovementTuningOverride& tuningOverride : TuningOverrides)
+		{
+			if (!tuningOverride.Apply(*OverriddenTuning))
 			{
-				OwnerRef->AddActorLocalOffset(CurrentDashDirection * CurrentSpeed);
+				UE_LOG(LogTemp, Warning, TEXT("%s: Unknown movement tuning override %s."), *GetNameSafe(GetOwner()), *tuningOverride.Property.ToString());
 			}
-			BlinkTime += DeltaTime;
+		}
+		ActiveTuning = OverriddenTuning.Get();
+	}
+	RefreshSimConfig();
+}
+
+void USymplAdvancedMovementComponent::OnMovementConfigChanged(USymplMovementConfig* Config)
+{
+	ApplyMovementConfig();
+}
+
+void USymplAdvancedMovementComponent::OnRep_MovementConfig()
+{
+	ApplyMovementConfig();
+}
+
+void USymplAdvancedMovementComponent::MigrateDeprecatedTuning()
+{
+	//The deprecated properties have the same names as the tuning properties.
+	UClass* nativeClass = USymplAdvancedMovementComponent::StaticClass();
+	const UObject* nativeDefaults = nativeClass->GetDefaultObject();
+	if (this == nativeDefaults)
+	{
+		return;
+	}
+	for (TFieldIterator<FProperty> it(FSymplMovementTuning::StaticStruct()); it; ++it)
+	{
+		const FProperty* property = FindFProperty<FProperty>(nativeClass, it->GetFName());
+		if (!property || property->Identical_InContainer(this, nativeDefaults))
+		{
+			continue;
+		}
+		const void* valuePtr = property->ContainerPtrToValuePtr<void>(this);
+		double value = 0.f;
+		if (const FNumericProperty* numericProperty = CastField<FNumericProperty>(property))
+		{
+			value = numericProperty->IsFloatingPoint() ? numericProperty->GetFloatingPointPropertyValue(valuePtr) : (double)numericProperty->GetSignedIntPropertyValue(valuePtr);
+		}
+		else if (const FBoolProperty* boolProperty = CastField<FBoolProperty>(property))
+		{
+			value = boolProperty->GetPropertyValue(valuePtr) ? 1.f : 0.f;
 		}
 		else
 		{
-			BlinkTime = 0.f;
-			if(bBlinking)
-				Server_Blink(false, FVector(), true);
+			continue;
 		}
-#pragma endregion
+		//An override set on purpose wins over a stale per component value.
+		FName name = property->GetFName();
+		const FName perSecondName = FSymplMovementTuning::GetPerSecondName(name);
+		if (!perSecondName.IsNone())
+		{
+			name = perSecondName;
+			value *= FSymplMovementTuning::PerFrameToPerSecond;
+		}
+		if (!TuningOverrides.ContainsByPredicate([name](const FSymplMovementTuningOverride& Other) { return Other.Property == name; }))
+		{
+			TuningOverrides.Emplace(name, value);
+			UE_LOG(LogTemp, Log, TEXT("%s: Moved deprecated tuning %s = %f into TuningOverrides."), *GetPathName(), *name.ToString(), value);
+		}
+		property->CopyCompleteValue_InContainer(this, nativeDefaults);
+	}
+}
 
-#pragma region ROLLING
-		//Handle rolling.
-		if (bRolling && CanRoll())
+void USymplAdvancedMovementComponent::SaveSnapshot(FSymplMovementSnapshot& Snapshot) const
+{
+	SYMPL_SCOPE(SaveSnapshot);
+	FSymplMovementSnapshotState state;
+	GetSnapshotState(state);
+	Snapshot.Write(state, GetServerWorldTime());
+}
+
+bool USymplAdvancedMovementComponent::RestoreSnapshot(const FSymplMovementSnapshot& Snapshot)
+{
+	SYMPL_SCOPE(RestoreSnapshot);
+	FSymplMovementSnapshotState state;
+	double savedTime = 0.f;
+	if (!Snapshot.Read(state, savedTime))
+	{
+		return false;
+	}
+	//Abilities and meters carry on from where they were saved, whenever and in whichever world we restore.
+	state.ShiftTime(GetServerWorldTime() - savedTime);
+	SetSnapshotState(state);
+	return true;
+}
+
+void USymplAdvancedMovementComponent::GetSnapshotState(FSymplMovementSnapshotState& State) const
+{
+	State.RuntimeState = RuntimeState;
+	//A mode staged this frame counts as committed.
+	if (bHasPendingMovementMode)
+	{
+		State.RuntimeState.LastMovementMode = PendingLastMovementMode;
+		State.RuntimeState.CurrentMovementMode = PendingMovementMode;
+	}
+	State.ModeStack = ModeStack;
+	State.DashCharges = DashCharges;
+	State.BlinkCharges = BlinkCharges;
+	State.RollCharges = RollCharges;
+	State.LastCharacterMovementMode = LastCharacterMovementMode;
+	State.LastBrakingFriction = LastBrakingFriction;
+	State.LastMaxAcceleration = LastMaxAcceleration;
+}
+
+void USymplAdvancedMovementComponent::SetSnapshotState(const FSymplMovementSnapshotState& State)
+{
+	const EAdvancedMovementMode from = RuntimeState.CurrentMovementMode;
+	const ESymplMovementSimFlags fromFlags = GetMovementState();
+	const ESymplMovementSimFlags toFlags = (ESymplMovementSimFlags)State.RuntimeState.MovementStateFlags;
+	//Undo the states we leave while the values they go back to are still ours.
+	ApplyOwnerMovementStates(fromFlags & ~toFlags, false);
+	RuntimeState = State.RuntimeState;
+	ModeStack = State.ModeStack;
+	DashCharges = State.DashCharges;
+	BlinkCharges = State.BlinkCharges;
+	RollCharges = State.RollCharges;
+	bHasPendingMovementMode = false;
+	bHasPendingLastMovementMode = false;
+	ApplyOwnerMovementStates(toFlags & ~fromFlags, true);
+	//Entering remembers the owner's current values, but the snapshot's are the ones to go back to.
+	LastCharacterMovementMode = State.LastCharacterMovementMode;
+	LastBrakingFriction = State.LastBrakingFriction;
+	LastMaxAcceleration = State.LastMaxAcceleration;
+	if (from != RuntimeState.CurrentMovementMode)
+	{
+		RefreshSimConfig();
+		//A rollback reports the mode it ends in once it is done.
+		if (RollbackDepth == 0)
 		{
-			if (OwnerAsChar)
+			MovementModeUpdate.Broadcast(this);
+			MovementModeTransition.Broadcast(this, from, RuntimeState.CurrentMovementMode);
+		}
+	}
+}
+
+void USymplAdvancedMovementComponent::ApplyOwnerMovementStates(ESymplMovementSimFlags Flags, bool bEnter)
+{
+	for (int32 i = 0; i < (int32)ESymplMovementState::Max; i++)
+	{
+		const ESymplMovementState state = (ESymplMovementState)i;
+		if (!SymplMovementStateMachine::IsActive(Flags, state))
+		{
+			continue;
+		}
+		bEnter ? OnEnterMovementState(state) : OnExitMovementState(state);
+		//Sliding and parachuting change the owner outside of the state hooks.
+		UCharacterMovementComponent* movement = OwnerAsChar ? OwnerAsChar->GetCharacterMovement() : nullptr;
+		if (state == ESymplMovementState::Sliding && movement)
+		{
+			movement->bOrientRotationToMovement = bEnter ? false : bOrientRotationToMovement;
+			movement->BrakingFriction = bEnter ? GetTuning().SlideBrakingFriction : LastBrakingFriction;
+			movement->SetMovementMode(bEnter ? MOVE_Falling : MOVE_Walking);
+		}
+		else if (state == ESymplMovementState::Parachuting)
+		{
+			if (bEnter)
 			{
-				OwnerAsChar->AddMovementInput((CurrentRollDirection * RollForce),1.f,false);
+				SpawnParachuteActor();
 			}
 			else
 			{
-				OwnerRef->AddActorLocalOffset(CurrentRollDirection * CurrentSpeed);
+				DestroyParachuteActor();
+			}
+			if (movement)
+			{
+				if (bEnter)
+				{
+					movement->SetMovementMode(MOVE_Falling);
+				}
+				else
+				{
+					RestoreLastCharacterMovementMode();
+				}
+				movement->MaxAcceleration = bEnter ? GetTuning().ParachuteMaxAcceleration : LastMaxAcceleration;
 			}
-			RollTime += DeltaTime;
+		}
+	}
+}
+
+bool USymplAdvancedMovementComponent::StartReplayRecording(const FString& Filename)
+{
+	if (!ReplayRecorder)
+	{
+		ReplayRecorder = MakeUnique<FSymplMovementReplayRecorder>();
+	}
+	if (!ReplayRecorder->Start(SymplMovementReplay::GetReplayPath(Filename), ReplayKeyframeInterval, ReplayFullKeyframeInterval))
+	{
+		ReplayRecorder.Reset();
+		return false;
+	}
+	return true;
+}
+
+void USymplAdvancedMovementComponent::StopReplayRecording()
+{
+	//Stops the recorder and waits for its writes.
+	ReplayRecorder.Reset();
+}
+
+bool USymplAdvancedMovementComponent::StartReplayPlayback(const FString& Filename)
+{
+	TUniquePtr<FSymplMovementReplayPlayer> player = MakeUnique<FSymplMovementReplayPlayer>();
+	if (!player->Load(SymplMovementReplay::GetReplayPath(Filename)))
+	{
+		return false;
+	}
+	ReplayPlayer = MoveTemp(player);
+	ReplayPlaybackStartTime = GetWorld()->GetTimeSeconds();
+	TickReplayPlayback();
+	return true;
+}
+
+void USymplAdvancedMovementComponent::StopReplayPlayback()
+{
+	ReplayPlayer.Reset();
+}
+
+void USymplAdvancedMovementComponent::TickReplayPlayback()
+{
+	SYMPL_SCOPE(ReplayPlayback);
+	//Follow the engine replay when one is playing, so pausing and scrubbing it moves the track too.
+	const UDemoNetDriver* demoDriver = GetWorld()->GetDemoNetDriver();
+	const bool bDemoPlayback = demoDriver && demoDriver->IsPlaying();
+	const double time = bDemoPlayback ? GetReplayTime() : ReplayPlayer->GetStartTime() + GetWorld()->GetTimeSeconds() - ReplayPlaybackStartTime;
+	FSymplMovementSnapshotState state;
+	if (ReplayPlayer->Evaluate(time, state))
+	{
+		//Ability timers and meters were recorded against the recording's clock.
+		state.ShiftTime(GetServerWorldTime() - time);
+		SetSnapshotState(state);
+		PublishAnimSnapshot();
+	}
+	//The engine replay can be scrubbed back into the track, so only stop on our own clock.
+	if (!bDemoPlayback && time > ReplayPlayer->GetEndTime())
+	{
+		StopReplayPlayback();
+	}
+}
+
+double USymplAdvancedMovementComponent::GetReplayTime() const
+{
+	const UDemoNetDriver* demoDriver = GetWorld()->GetDemoNetDriver();
+	if (demoDriver && (demoDriver->IsRecording() || demoDriver->IsPlaying()))
+	{
+		return demoDriver->GetDemoCurrentTime();
+	}
+	return GetServerWorldTime();
+}
+
+void USymplAdvancedMovementComponent::StepFixedTick(const FSymplMovementSimInput& Input, double StepTime)
+{
+	if (bFixedTickSimulation)
+	{
+		if (RollbackBuffer.Capacity() <= 0)
+		{
+			RollbackBuffer.Init(RollbackFrames);
+		}
+		FSymplMovementRollbackFrame& frame = RollbackBuffer.Add(SimFrame);
+		GetSnapshotState(frame.State);
+		frame.Transform = OwnerRef ? OwnerRef->GetActorTransform() : FTransform::Identity;
+		frame.Velocity = RuntimeState.CurrentVelocity;
+		frame.Input = Input;
+	}
+	ApplySimResult(SymplMovementSimulation::Step(SimConfig, GatherSimState(), Input, StepTime, *this));
+	SYMPL_COUNT(SimSteps, 1);
+	SimFrame++;
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		LastSimTime = Input.Time;
+	}
+}
+
+double USymplAdvancedMovementComponent::GetFixedStepTime() const
+{
+	if (bFixedTickSimulation)
+	{
+		return 1.f / FMath::Max(FixedTickRate, 1);
+	}
+	if (IsServerFixedRate())
+	{
+		return 1.f / GetDefault<USymplAdvancedMovementSettings>()->ServerSimulationRate;
+	}
+	return 0.f;
+}
+
+bool USymplAdvancedMovementComponent::IsServerFixedRate() const
+{
+	return GetDefault<USymplAdvancedMovementSettings>()->ServerSimulationRate > 0.f && GetOwnerRole() == ROLE_Authority && GetNetMode() == NM_DedicatedServer;
+}
+
+void USymplAdvancedMovementComponent::OnRep_LastSimTime()
+{
+	if (!GetDefault<USymplAdvancedMovementSettings>()->bInterpolateSimulatedProxies)
+	{
+		return;
+	}
+	SimSamples[0] = SimSamples[1];
+	SimSamples[1].Time = LastSimTime;
+	SimSamples[1].Velocity = RuntimeState.CurrentVelocity;
+	SimSamples[1].Speed = RuntimeState.CurrentSpeed;
+	SimSamples[1].SlopeAngle = RuntimeState.CurrentSlopeAngle;
+}
+
+void USymplAdvancedMovementComponent::InterpolateSimulatedProxy(FSymplMovementAnimSnapshot& Snapshot) const
+{
+	const USymplAdvancedMovementSettings* settings = GetDefault<USymplAdvancedMovementSettings>();
+	const FSimSample& from = SimSamples[0];
+	const FSimSample& to = SimSamples[1];
+	if (!settings->bInterpolateSimulatedProxies || settings->ServerSimulationRate <= 0.f || GetOwnerRole() != ROLE_SimulatedProxy || from.Time < 0.f || to.Time <= from.Time)
+	{
+		return;
+	}
+	//Display one simulation step behind so there is usually a state on either side.
+	const double renderTime = GetServerWorldTime() - 1.f / settings->ServerSimulationRate;
+	const double alpha = FMath::Clamp((renderTime - from.Time) / (to.Time - from.Time), 0.0, 1.0);
+	Snapshot.Velocity = FMath::Lerp(from.Velocity, to.Velocity, alpha);
+	Snapshot.Speed = FMath::Lerp(from.Speed, to.Speed, alpha);
+	Snapshot.SlopeAngle = FMath::Lerp(from.SlopeAngle, to.SlopeAngle, alpha);
+}
+
+bool USymplAdvancedMovementComponent::Rewind(int32 Frame)
+{
+	SYMPL_SCOPE(Rewind);
+	const FSymplMovementRollbackFrame* frame = RollbackBuffer.Find(Frame);
+	if (!frame)
+	{
+		return false;
+	}
+	TGuardValue<int32> restoring(RollbackDepth, RollbackDepth + 1);
+	SetSnapshotState(frame->State);
+	if (OwnerRef)
+	{
+		OwnerRef->SetActorTransform(frame->Transform, false, nullptr, ETeleportType::TeleportPhysics);
+	}
+	if (OwnerAsPawn && OwnerAsPawn->GetMovementComponent())
+	{
+		OwnerAsPawn->GetMovementComponent()->Velocity = frame->Velocity;
+	}
+	RuntimeState.CurrentVelocity = frame->Velocity;
+	SimFrame = Frame;
+	return true;
+}
+
+//The part of a simulation state ApplySimResult writes back into the runtime state.
+static void WriteSimState(const FSymplMovementSimResult& Result, FSymplMovementRuntimeState& State)
+{
+	State.CurrentSlopeAngle = Result.State.SlopeAngle;
+	State.CurrentSlopeSpeedScalar = Result.State.SlopeSpeedScalar;
+	State.CurrentSpeed = Result.State.Speed;
+	State.CurrentMovementType = Result.State.MovementType;
+	State.JetpackFuel = Result.State.JetpackFuel;
+	State.SprintStamina = Result.State.SprintStamina;
+	if (Result.Has(ESymplMovementSimEvents::Jetpacking))
+	{
+		State.CurrentVelocity = Result.JetpackVelocity;
+	}
+}
+
+void USymplAdvancedMovementComponent::Resimulate(int32 ToFrame)
+{
+	SYMPL_SCOPE(Resimulate);
+	if (SimFrame >= ToFrame)
+	{
+		return;
+	}
+	//Step the state only. Launches, forces and rpcs would repeat once per replayed frame, so only the last step is applied.
+	const double stepTime = GetFixedStepTime();
+	const int32 fromFrame = SimFrame;
+	FSymplMovementSimState state = GatherSimState();
+	FSymplMovementSimResult result;
+	double time = GetServerWorldTime();
+	while (SimFrame < ToFrame)
+	{
+		FSymplMovementRollbackFrame* frame = RollbackBuffer.Find(SimFrame);
+		FSymplMovementSimInput input;
+		if (frame)
+		{
+			//Later rollbacks start from the corrected state.
+			if (SimFrame != fromFrame)
+			{
+				WriteSimState(result, frame->State.RuntimeState);
+			}
+			input = frame->Input;
+		}
+		else
+		{
+			input = GatherSimInput();
+			input.Time = time + stepTime;
+		}
+		result = SymplMovementSimulation::Step(SimConfig, state, input, stepTime, *this);
+		state = result.State;
+		time = input.Time;
+		SYMPL_COUNT(SimSteps, 1);
+		SimFrame++;
+	}
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		LastSimTime = time;
+	}
+	//Server rpcs we call from here are not rate limited.
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
+	ApplySimResult(result);
+	CommitMovementMode();
+}
+
+bool USymplAdvancedMovementComponent::Rollback(int32 Frame)
+{
+	const int32 current = SimFrame;
+	//Rewinding restores the input of that frame, keep the live one.
+	const double forward = RuntimeState.ForwardInput;
+	const double right = RuntimeState.RightInput;
+	const double up = RuntimeState.UpInput;
+	//Resimulate doesn't move the owner, so put it back where it was instead of leaving it at Frame.
+	const FTransform transform = OwnerRef ? OwnerRef->GetActorTransform() : FTransform::Identity;
+	const FVector velocity = RuntimeState.CurrentVelocity;
+	const FVector ownerVelocity = OwnerAsPawn && OwnerAsPawn->GetMovementComponent() ? OwnerAsPawn->GetMovementComponent()->Velocity : FVector::ZeroVector;
+	const EAdvancedMovementMode from = RuntimeState.CurrentMovementMode;
+	{
+		//Listeners only hear where the rollback ends, not every mode it passes through.
+		TGuardValue<int32> restoring(RollbackDepth, RollbackDepth + 1);
+		if (!Rewind(Frame))
+		{
+			return false;
+		}
+		if (OwnerRef)
+		{
+			OwnerRef->SetActorTransform(transform, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+		if (OwnerAsPawn && OwnerAsPawn->GetMovementComponent())
+		{
+			OwnerAsPawn->GetMovementComponent()->Velocity = ownerVelocity;
+		}
+		//Resimulate from the rewound velocity, then carry on from the owner's. The last step sets it when it changes it.
+		Resimulate(current);
+	}
+	RuntimeState.CurrentVelocity = OwnerAsPawn && OwnerAsPawn->GetMovementComponent() ? OwnerAsPawn->GetMovementComponent()->Velocity : velocity;
+	RuntimeState.ForwardInput = forward;
+	RuntimeState.RightInput = right;
+	RuntimeState.UpInput = up;
+	if (from != RuntimeState.CurrentMovementMode)
+	{
+		MovementModeUpdate.Broadcast(this);
+		MovementModeTransition.Broadcast(this, from, RuntimeState.CurrentMovementMode);
+	}
+	return true;
+}
+
+bool USymplAdvancedMovementComponent::SetFrameInput(int32 Frame, FVector MoveInput)
+{
+	FSymplMovementRollbackFrame* frame = RollbackBuffer.Find(Frame);
+	if (!frame)
+	{
+		return false;
+	}
+	frame->Input.MoveInput = MoveInput;
+	return true;
+}
+
+void USymplAdvancedMovementComponent::UnbindMovementConfig()
+{
+	if (USymplMovementConfig* bound = BoundConfig.Get())
+	{
+		bound->OnTuningChanged.Remove(ConfigChangedHandle);
+	}
+	BoundConfig.Reset();
+	ConfigChangedHandle.Reset();
+}
+
+FSymplMovementSimInput USymplAdvancedMovementComponent::GatherSimInput() const
+{
+	FSymplMovementSimInput input;
+	input.MoveInput = FVector(RuntimeState.ForwardInput, RuntimeState.RightInput, RuntimeState.UpInput);
+	input.Velocity = RuntimeState.CurrentVelocity;
+	input.bHasAuthority = GetOwnerRole() == ROLE_Authority;
+	input.bIsCharacter = OwnerAsChar != nullptr;
+	input.Time = GetServerWorldTime();
+	input.FrameFraction = SimStepFrameFraction;
+	if (OwnerRef)
+	{
+		input.Rotation = OwnerRef->GetActorQuat();
+	}
+	if (OwnerAsChar)
+	{
+		const UCharacterMovementComponent* movement = OwnerAsChar->GetCharacterMovement();
+		input.bFalling = movement->IsFalling();
+		input.FloorAngle = UKismetMathLibrary::DegAcos(movement->CurrentFloor.HitResult.ImpactNormal.Dot(FVector(0.f, 0.f, 1.f)));
+	}
+	else if (OwnerAsPawn && OwnerAsPawn->GetMovementComponent())
+	{
+		input.bFalling = OwnerAsPawn->GetMovementComponent()->IsFalling();
+	}
+	return input;
+}
+
+void USymplAdvancedMovementComponent::ApplySimResult(const FSymplMovementSimResult& Result)
+{
+	SYMPL_SCOPE(ApplySimResult);
+	const FSymplMovementSimState& state = Result.State;
+	RuntimeState.CurrentSlopeAngle = state.SlopeAngle;
+	RuntimeState.CurrentSlopeSpeedScalar = state.SlopeSpeedScalar;
+	RuntimeState.CurrentSpeed = state.Speed;
+	RuntimeState.CurrentMovementType = state.MovementType;
+
+#pragma region SPEED
+	if (Result.Has(ESymplMovementSimEvents::SpeedChanged))
+	{
+		SYMPL_SCOPE(Speed);
+		ApplyCharacterSpeed();
+	}
+#pragma endregion
+
+#pragma region SLIDING
+	if (Result.Has(ESymplMovementSimEvents::Sliding))
+	{
+		SYMPL_SCOPE(Sliding);
+		if (OwnerAsChar)
+		{
+			//Set movement defaults for character and add force.
+			OwnerAsChar->GetCharacterMovement()->bOrientRotationToMovement = false;
+			OwnerAsChar->GetCharacterMovement()->SetMovementMode(MOVE_Falling);
+			OwnerAsChar->GetCharacterMovement()->BrakingFriction = GetTuning().SlideBrakingFriction;
+			OwnerAsChar->GetCharacterMovement()->AddForce(Result.SlideForce);
+		}
+		else
+		{
+			OwnerRef->AddActorLocalOffset(Result.SlideForce);
+		}
+	}
+	else if (Result.Has(ESymplMovementSimEvents::SlideReset) && OwnerAsChar)
+	{
+		//Reset sliding.
+		OwnerAsChar->GetCharacterMovement()->BrakingFriction = LastBrakingFriction;
+		OwnerAsChar->GetCharacterMovement()->bOrientRotationToMovement = bOrientRotationToMovement;
+		OwnerAsChar->GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+	}
+#pragma endregion
+
+#pragma region DASHING
+	if (Result.Has(ESymplMovementSimEvents::Dashing))
+	{
+		SYMPL_SCOPE(Dashing);
+		if (OwnerAsChar)
+		{
+			OwnerAsChar->LaunchCharacter(Result.DashLaunch, true, true);
 		}
 		else
 		{
-			RollTime = 0.f;
-			if(bRolling)
-				Server_Roll(false, FVector(), true);
+			OwnerRef->AddActorLocalOffset(Result.DashLaunch);
 		}
+	}
+	else if (Result.Has(ESymplMovementSimEvents::DashEnded))
+	{
+		Server_Dash(false, FVector(), true);
+	}
 #pragma endregion
 
-#pragma region HOVERING
-		if (bHovering && CanHover())
+#pragma region BLINKING
+	if (Result.Has(ESymplMovementSimEvents::Blinking))
+	{
+		SYMPL_SCOPE(Blinking);
+		if (OwnerAsChar)
+		{
+			OwnerAsChar->LaunchCharacter(Result.BlinkLaunch, true, true);
+		}
+		else
+		{
+			OwnerRef->AddActorLocalOffset(Result.BlinkLaunch);
+		}
+	}
+	else if (Result.Has(ESymplMovementSimEvents::BlinkEnded))
+	{
+		Server_Blink(false, FVector(), true);
+	}
+#pragma endregion
+
+#pragma region ROLLING
+	if (Result.Has(ESymplMovementSimEvents::Rolling))
+	{
+		SYMPL_SCOPE(Rolling);
+		if (OwnerAsChar)
 		{
-			HoverTime += DeltaTime;
+			OwnerAsChar->AddMovementInput(Result.RollInput, 1.f, false);
 		}
 		else
 		{
-			if(bHovering)
-				Server_SetHovering(false, true);
+			OwnerRef->AddActorLocalOffset(Result.RollInput);
 		}
+	}
+	else if (Result.Has(ESymplMovementSimEvents::RollEnded))
+	{
+		Server_Roll(false, FVector(), true);
+	}
+#pragma endregion
+
+#pragma region HOVERING
+	if (Result.Has(ESymplMovementSimEvents::HoverEnded))
+	{
+		Server_SetHovering(false, true);
+	}
 #pragma endregion
 
 #pragma region ZEROG
-
-		if (bZeroGMovement)
-		{
-			// Normalize the input vector
-			FVector InputVector = FVector(ForwardInput, RightInput, UpInput).GetClampedToMaxSize(1.0f);
-
-			// Get the character's rotation and apply it to the input vector
-			FVector CharacterDirection = OwnerRef->GetActorRotation().RotateVector(InputVector);
-
-			// Apply the movement to the character
-			FVector NewLocation = OwnerRef->GetActorLocation() + CharacterDirection * CurrentSpeed * DeltaTime;
-			OwnerRef->SetActorLocation(NewLocation);
-		}
-
+	if (Result.Has(ESymplMovementSimEvents::ZeroGMoved))
+	{
+		SYMPL_SCOPE(ZeroG);
+		OwnerRef->SetActorLocation(OwnerRef->GetActorLocation() + Result.ZeroGDelta);
 	}
 #pragma endregion
 
 #pragma region JETPACK
-
-	if (bJetpackActive && CurrentJetpackFuel >= RequiredFuelForJetpack)
+	if (Result.Has(ESymplMovementSimEvents::Jetpacking))
 	{
-		FVector vel = FVector::UpVector * JetpackForce;
-		vel += CurrentVelocity;
+		SYMPL_SCOPE(Jetpack);
 		if (OwnerAsChar)
 		{
-			OwnerAsChar->GetCharacterMovement()->Velocity = vel;
+			OwnerAsChar->GetCharacterMovement()->Velocity = Result.JetpackVelocity;
+			//The next substep starts from the new velocity.
+			RuntimeState.CurrentVelocity = Result.JetpackVelocity;
+		}
+		else if (OwnerRef->GetRootComponent()->IsSimulatingPhysics())
+		{
+			Cast<UPrimitiveComponent>(OwnerRef->GetRootComponent())->AddForce(Result.JetpackPhysicsAcceleration, NAME_None, true);
 		}
 		else
 		{
-			if (OwnerRef->GetRootComponent()->IsSimulatingPhysics())
-			{
-				Cast<UPrimitiveComponent>(OwnerRef->GetRootComponent())->AddForce(vel);
-			}
-			else
-			{
-				OwnerRef->AddActorLocalOffset(vel);
-			}
+			OwnerRef->AddActorLocalOffset(Result.JetpackDelta);
 		}
-		if(CurrentJetpackFuel != 0.f)
-			Server_SetJetpackFuel(CurrentJetpackFuel-JetpackDrainRate);
 	}
-	else
+	//The server runs the same meter, so only the events replicate.
+	RuntimeState.JetpackFuel = state.JetpackFuel;
+	if (Result.Has(ESymplMovementSimEvents::FuelChanged))
 	{
-		if (bRestoreJetpackFuelWhenInactive && CurrentJetpackFuel != MaxJetpackFuel)
-			Server_SetJetpackFuel(CurrentJetpackFuel + JetpackRefuelRate);
+		JetpackFuelUpdate.Broadcast(this);
 	}
+	//Out of fuel, the jetpack has to be pressed again once it refuels.
+	if (Result.Has(ESymplMovementSimEvents::JetpackDepleted) && GetOwnerRole() == ROLE_Authority)
+	{
+		ExitMovementState(ESymplMovementState::Jetpack);
+		DidJetpack.Broadcast(this);
+	}
+#pragma endregion
 
+#pragma region STAMINA
+	RuntimeState.SprintStamina = state.SprintStamina;
+	if (Result.Has(ESymplMovementSimEvents::StaminaChanged))
+	{
+		SprintStaminaUpdate.Broadcast(this);
+	}
+	//Out of stamina, stop sprinting. The state replicates from the server.
+	if (Result.Has(ESymplMovementSimEvents::StaminaDepleted) && GetOwnerRole() == ROLE_Authority)
+	{
+		ExitMovementState(ESymplMovementState::Sprinting);
+	}
 #pragma endregion
+}
 
-#pragma region LOCATIONS
+void USymplAdvancedMovementComponent::ApplyCharacterSpeed()
+{
+	if (!OwnerAsChar)
+	{
+		return;
+	}
+	if (RuntimeState.CurrentMovementMode == EAdvancedMovementMode::EFLY)
+	{
+		OwnerAsChar->GetCharacterMovement()->MaxFlySpeed = RuntimeState.CurrentSpeed;
+	}
+	else if (RuntimeState.CurrentMovementMode == EAdvancedMovementMode::ECROUCH)
+	{
+		OwnerAsChar->GetCharacterMovement()->MaxWalkSpeedCrouched = RuntimeState.CurrentSpeed;
+	}
+	else
+	{
+		OwnerAsChar->GetCharacterMovement()->MaxWalkSpeed = RuntimeState.CurrentSpeed;
+	}
+}
 
-	if(OwnerRef->GetClass()->ImplementsInterface(USymplAdvancedMovementInterface::StaticClass()))
+double USymplAdvancedMovementComponent::QuerySlopeAngle() const
+{
+	SYMPL_SCOPE(SlopeCalculations);
+	if (OwnerAsChar && !bForceCustomSlopeTrace)
 	{
-		bool falling = ISymplAdvancedMovementInterface::Execute_SymplIsFalling(OwnerRef);
-		if (!falling)
-		{
-			LastGroundLocation = OwnerRef->GetActorLocation();
-		}
-		else
-		{
-			LastAirLocation = OwnerRef->GetActorLocation();
-		}
+		//Get the slope angle from the find floor result.
+		return FMath::RadiansToDegrees(FMath::Acos(OwnerAsChar->GetCharacterMovement()->CurrentFloor.HitResult.ImpactNormal.Z));
 	}
+	//Trace for slope
+	FVector up = OwnerRef->GetActorUpVector();
+	FVector down = up * -1.0f;
 
-#pragma endregion
+	FHitResult hit;
+	FCollisionQueryParams params;
+	FCollisionResponseParams response;
+	FCollisionShape shape;
+	shape.MakeSphere(1.f);
+	params.bFindInitialOverlaps = true;
 
+	SYMPL_COUNT(Traces, 1);
+	if (GetWorld()->SweepSingleByChannel(hit, OwnerRef->GetActorLocation(), OwnerRef->GetActorLocation() + down * 100.0f, FQuat(), SlopeTraceChannel, shape, params, response))
+	{
+		return FMath::RadiansToDegrees(FMath::Acos(hit.ImpactNormal | up));
+	}
+	//No hit so we assume we are on an even plane.
+	return 0.f;
+}
+
+double USymplAdvancedMovementComponent::QuerySlopeSpeedScalar(double SlopeAngle) const
+{
+	return SlopeSpeedCurve ? SlopeSpeedCurve->GetFloatValue(SlopeAngle) : 1.f;
+}
+
+bool USymplAdvancedMovementComponent::QueryModeSpeed(EAdvancedMovementMode Mode, double& OutSpeed) const
+{
+	for (const FSymplMovementSpeeds& speed : SelectedSpeeds)
+	{
+		if (speed.MovementMode == Mode)
+		{
+			OutSpeed = speed.Speed;
+			return true;
+		}
+	}
+	return false;
 }
 
 // Replication
@@ -453,49 +1645,148 @@ void USymplAdvancedMovementComponent::GetLifetimeReplicatedProps(TArray<FLifetim
 	DOREPLIFETIME(USymplAdvancedMovementComponent, SelectedSpeeds);
 	DOREPLIFETIME(USymplAdvancedMovementComponent, CurrentMovementSpeed);
 	//DOREPLIFETIME(USymplAdvancedMovementComponent, CurrentMovementAnimations);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, CurrentMovementType);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, CurrentMovementMode);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, LastMovementMode);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, LastCharacterMovementMode);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, bZeroGMovement);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, bJetpackActive);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, bAutoRunEnabled);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, bInitialized);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, bIsParachuting);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, bHovering);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, bDidJump);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, bDashing);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, bRolling);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, bBlinking);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, bProne);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, bSprinting);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, bSliding);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, bCrouching);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, DoubleJumpCounter);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, ForwardInput);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, RightInput);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, UpInput);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, CurrentJetpackFuel);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, CurrentSlopeAngle);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, CurrentSlopeSpeedScalar);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, ClimbTime);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, RollTime);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, DashTime);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, BlinkTime);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, SlideTime);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, HoverTime);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, CurrentSpeed);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, LastMaxAcceleration);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, LastBrakingFriction);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, CurrentDashDirection);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, CurrentBlinkDirection);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, CurrentRollDirection);
+	DOREPLIFETIME_CONDITION(USymplAdvancedMovementComponent, LastCharacterMovementMode, COND_Custom);
+	DOREPLIFETIME_CONDITION(USymplAdvancedMovementComponent, RuntimeState, COND_Custom);
+	DOREPLIFETIME_CONDITION(USymplAdvancedMovementComponent, DashCharges, COND_Custom);
+	DOREPLIFETIME_CONDITION(USymplAdvancedMovementComponent, BlinkCharges, COND_Custom);
+	DOREPLIFETIME_CONDITION(USymplAdvancedMovementComponent, RollCharges, COND_Custom);
+	DOREPLIFETIME_CONDITION(USymplAdvancedMovementComponent, LastMaxAcceleration, COND_Custom);
+	DOREPLIFETIME_CONDITION(USymplAdvancedMovementComponent, LastBrakingFriction, COND_Custom);
 	DOREPLIFETIME(USymplAdvancedMovementComponent, LastGroundLocation);
+	DOREPLIFETIME(USymplAdvancedMovementComponent, MovementConfig);
+	DOREPLIFETIME(USymplAdvancedMovementComponent, TuningOverrides);
 	DOREPLIFETIME(USymplAdvancedMovementComponent, LastAirLocation);
-	DOREPLIFETIME(USymplAdvancedMovementComponent, CurrentVelocity);
+	DOREPLIFETIME_CONDITION(USymplAdvancedMovementComponent, LastSimTime, COND_SimulatedOnly);
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 }
 
+void USymplAdvancedMovementComponent::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+	//Don't replicate a stale mode if we haven't ticked since it was staged.
+	CommitMovementMode();
+	//The movement track carries the snapshot state while it records, so keep it out of the engine replay.
+	const bool bReplicateSnapshotState = !ChangedPropertyTracker.IsReplay() || !IsRecordingReplay();
+	DOREPLIFETIME_ACTIVE_OVERRIDE(USymplAdvancedMovementComponent, RuntimeState, bReplicateSnapshotState);
+	DOREPLIFETIME_ACTIVE_OVERRIDE(USymplAdvancedMovementComponent, DashCharges, bReplicateSnapshotState);
+	DOREPLIFETIME_ACTIVE_OVERRIDE(USymplAdvancedMovementComponent, BlinkCharges, bReplicateSnapshotState);
+	DOREPLIFETIME_ACTIVE_OVERRIDE(USymplAdvancedMovementComponent, RollCharges, bReplicateSnapshotState);
+	DOREPLIFETIME_ACTIVE_OVERRIDE(USymplAdvancedMovementComponent, LastCharacterMovementMode, bReplicateSnapshotState);
+	DOREPLIFETIME_ACTIVE_OVERRIDE(USymplAdvancedMovementComponent, LastMaxAcceleration, bReplicateSnapshotState);
+	DOREPLIFETIME_ACTIVE_OVERRIDE(USymplAdvancedMovementComponent, LastBrakingFriction, bReplicateSnapshotState);
+	if (IsNetStatsEnabled())
+	{
+		RecordPropertyChanges();
+	}
+}
+
+bool USymplAdvancedMovementComponent::IsNetStatsEnabled()
+{
+	return CVarSymplNetStats.GetValueOnGameThread() != 0;
+}
+
+void USymplAdvancedMovementComponent::RecordRpc(ESymplMovementRpc Rpc)
+{
+	if (!IsNetStatsEnabled() || GetOwnerRole() != ROLE_Authority || GetNetMode() == NM_Standalone)
+	{
+		return;
+	}
+	const FName name = SymplMovementNetStats::GetRpcFunctionName(Rpc);
+	const UFunction* function = FindFunction(name);
+	//The parameter struct size, not the serialized payload.
+	const int32 bytes = function ? function->ParmsSize : 0;
+	const bool bReliable = function && function->HasAnyFunctionFlags(FUNC_NetReliable);
+	float pressure = 0.f;
+	if (bReliable)
+	{
+		//How full the owner's actor channel reliable buffer is.
+		UNetConnection* connection = GetOwner()->GetNetConnection();
+		if (UActorChannel* channel = connection ? connection->FindActorChannelRef(GetOwner()) : nullptr)
+		{
+			pressure = (float)channel->NumOutRec / RELIABLE_BUFFER;
+		}
+	}
+	NetStats.RecordRpc(Rpc, bytes, bReliable, pressure);
+	CSV_CUSTOM_STAT(SymplMovementNet, RpcCalls, 1, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(SymplMovementNet, RpcBytes, bytes, ECsvCustomStatOp::Accumulate);
+#if CSV_PROFILER
+	FCsvProfiler::RecordCustomStat(name, CSV_CATEGORY_INDEX(SymplMovementNet), 1, ECsvCustomStatOp::Accumulate);
+#endif
+}
+
+void USymplAdvancedMovementComponent::RecordPropertyChanges()
+{
+	SYMPL_SCOPE(RecordPropertyChanges);
+	//Gather our replicated properties and make a copy of them the first time.
+	if (!NetStats.HasProperties())
+	{
+		TArray<FName> names;
+		for (TFieldIterator<FProperty> it(GetClass()); it; ++it)
+		{
+			if (it->HasAnyPropertyFlags(CPF_Net))
+			{
+				NetStatsProperties.Add(*it);
+				names.Add(it->GetFName());
+			}
+		}
+		NetStatsShadow.SetNumZeroed(GetClass()->GetPropertiesSize());
+		for (FProperty* property : NetStatsProperties)
+		{
+			property->InitializeValue_InContainer(NetStatsShadow.GetData());
+		}
+		NetStats.InitProperties(names);
+	}
+
+	for (int32 i = 0; i < NetStatsProperties.Num(); i++)
+	{
+		FProperty* property = NetStatsProperties[i];
+		bool identical = true;
+		for (int32 index = 0; index < property->ArrayDim && identical; index++)
+		{
+			identical = property->Identical_InContainer(this, NetStatsShadow.GetData(), index);
+		}
+		if (identical)
+		{
+			continue;
+		}
+		property->CopyCompleteValue_InContainer(NetStatsShadow.GetData(), this);
+		int32 bytes = property->GetSize();
+		if (const FArrayProperty* array = CastField<FArrayProperty>(property))
+		{
+			FScriptArrayHelper helper(array, array->ContainerPtrToValuePtr<void>(this));
+			bytes = helper.Num() * array->Inner->GetSize();
+		}
+		NetStats.RecordProperty(i, bytes);
+		CSV_CUSTOM_STAT(SymplMovementNet, PropertyChanges, 1, ECsvCustomStatOp::Accumulate);
+		CSV_CUSTOM_STAT(SymplMovementNet, PropertyBytes, bytes, ECsvCustomStatOp::Accumulate);
+#if CSV_PROFILER
+		FCsvProfiler::RecordCustomStat(property->GetFName(), CSV_CATEGORY_INDEX(SymplMovementNet), bytes, ECsvCustomStatOp::Accumulate);
+#endif
+	}
+}
+
+void USymplAdvancedMovementComponent::ResetNetStats()
+{
+	if (NetStatsShadow.Num() > 0)
+	{
+		for (FProperty* property : NetStatsProperties)
+		{
+			property->DestroyValue_InContainer(NetStatsShadow.GetData());
+		}
+	}
+	NetStatsProperties.Reset();
+	NetStatsShadow.Reset();
+	NetStats.InitProperties(TArray<FName>());
+	NetStats.Reset();
+}
+
+FSymplMovementNetStats USymplAdvancedMovementComponent::GetNetStats() const
+{
+	FSymplMovementNetStats stats;
+	NetStats.Fill(stats);
+	return stats;
+}
+
 void USymplAdvancedMovementComponent::CustomJump_Implementation(bool bPressed, bool bDoubleJump)
 {
 	//Call c++ function by default.
@@ -509,13 +1800,14 @@ void USymplAdvancedMovementComponent::CustomJump_Impl(bool bPressed, bool bDoubl
 	{
 		return;
 	}
-	Server_SetMovementMode(EAdvancedMovementMode::EJUMP);
+	SetMovementModeIfChanged(EAdvancedMovementMode::EJUMP);
 	OwnerRef->AddActorLocalOffset(CustomJumpVelocity);
 	OwnerJump.Broadcast(this, true, bDoubleJump);
 }
 
 bool USymplAdvancedMovementComponent::ClimbCheck(USceneComponent* WallDetect, TEnumAsByte<EMovementAnimType> MovementType, double DeltaTime, FVector Velocity)
 {
+	SYMPL_SCOPE(ClimbCheck);
 	//Sweep for walls and run wall run or climb.
 	bool success = false;
 	FHitResult hit;
@@ -523,19 +1815,20 @@ bool USymplAdvancedMovementComponent::ClimbCheck(USceneComponent* WallDetect, TE
 	FCollisionShape shape;
 	FCollisionQueryParams params;
 	FCollisionResponseParams response;
-	shape.MakeSphere(WallDetectTraceRadius);
+	shape.MakeSphere(GetTuning().WallDetectTraceRadius);
 	params.AddIgnoredActor(OwnerRef);
-	if (WallDetect && bDidJump)
+	if (WallDetect && RuntimeState.bDidJump)
 	{
 		loc = WallDetect->GetComponentLocation();
+		SYMPL_COUNT(Traces, 1);
 		success = GetWorld()->SweepSingleByChannel(hit, OwnerRef->GetActorLocation(), loc, FQuat(), WallDetectCollisionChannel, shape, params, response);
 		if (success)
 		{
 			UE_LOG(LogTemp,Warning,TEXT("%s"), *hit.ToString());
-			if (MaxWallRun_ClimbTime <= 0 || ClimbTime < MaxWallRun_ClimbTime)
+			if (GetTuning().MaxWallRun_ClimbTime <= 0 || GetAbilityTime(RuntimeState.ClimbStartTime) < GetTuning().MaxWallRun_ClimbTime)
 			{
 				//Do climb.
-				Server_DoClimb(MovementType, Velocity, DeltaTime);
+				Server_DoClimb(MovementType, Velocity, DeltaTime, GetServerWorldTime());
 			}
 		}
 		return success;
@@ -543,8 +1836,27 @@ bool USymplAdvancedMovementComponent::ClimbCheck(USceneComponent* WallDetect, TE
 	return false;
 }
 
-void USymplAdvancedMovementComponent::Server_DoClimb_Implementation(EMovementAnimType AnimType, FVector LaunchVelocity, double DeltaTime)
+void USymplAdvancedMovementComponent::Server_DoClimb_Implementation(EMovementAnimType AnimType, FVector LaunchVelocity, double DeltaTime, double ClientTime)
 {
+	SYMPL_SCOPE(Server_DoClimb);
+	if (!AcceptServerRpc(ESymplMovementRpc::EDOCLIMB))
+	{
+		return;
+	}
+	//A client can't launch harder than a wall run or climb would.
+	if (IsClientServerRpc() && LaunchVelocity.Size() > GetTuning().WallRun_ClimbLaunchVelocityScalar + 1.f)
+	{
+		RejectServerRpc(ESymplMovementRpc::EDOCLIMB);
+		return;
+	}
+	//Make sure there was a wall where the client was.
+	if (IsClientServerRpc() && !ValidateClientClimb(AnimType, ClientTime))
+	{
+		RejectServerRpc(ESymplMovementRpc::EDOCLIMB);
+		SendMovementCorrection();
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
 	//Climb movement.
  	if (OwnerAsChar)
 	{
@@ -554,16 +1866,29 @@ void USymplAdvancedMovementComponent::Server_DoClimb_Implementation(EMovementAni
 	{
 		CustomJump(true, true);
 	}
-	Server_SetMovementMode(EAdvancedMovementMode::ECLIMBING);
-	CurrentMovementType = AnimType;
-	ClimbTime += DeltaTime;
+	SetMovementModeIfChanged(EAdvancedMovementMode::ECLIMBING);
+	RuntimeState.CurrentMovementType = AnimType;
+	//The climb timer runs from the first climb until we land.
+	if (RuntimeState.ClimbStartTime < 0.f)
+	{
+		RuntimeState.ClimbStartTime = GetServerWorldTime();
+	}
 	DidClimb.Broadcast(this);
 }
 
-bool USymplAdvancedMovementComponent::Server_DoClimb_Validate(EMovementAnimType AnimType, FVector LaunchVelocity, double DeltaTime){ return true;}
+bool USymplAdvancedMovementComponent::Server_DoClimb_Validate(EMovementAnimType AnimType, FVector LaunchVelocity, double DeltaTime, double ClientTime)
+{
+	return AnimType <= EMovementAnimType::ESLIDING && !LaunchVelocity.ContainsNaN() && FMath::IsFinite(DeltaTime) && DeltaTime >= 0.f && FMath::IsFinite(ClientTime);
+}
 
 void USymplAdvancedMovementComponent::Server_AdvancedJump_Implementation(bool bPressed)
 {
+	SYMPL_SCOPE(Server_AdvancedJump);
+	if (!AcceptServerRpc(ESymplMovementRpc::EADVANCEDJUMP))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
 	//Jump or climb.
 	if (OwnerAsChar && !bForceCustomJump)
 	{
@@ -571,23 +1896,25 @@ void USymplAdvancedMovementComponent::Server_AdvancedJump_Implementation(bool bP
 		{
 			RestoreLastMovementMode();
 			OwnerAsChar->StopJumping();
+			RecordRpc(ESymplMovementRpc::ECLIENTJUMP);
 			Client_Jump(false);
 			return;
 		}
 		if (CanDoubleJump())
 		{
-			Server_SetMovementMode(EAdvancedMovementMode::EJUMP);
-			DoubleJumpCounter++;
-			OwnerAsChar->LaunchCharacter(DoubleJumpVelocity + CurrentVelocity,bDoubleJumpXYOverride,bDoubleJumpZOverride);
+			SetMovementModeIfChanged(EAdvancedMovementMode::EJUMP);
+			RuntimeState.DoubleJumpCounter++;
+			OwnerAsChar->LaunchCharacter(DoubleJumpVelocity + RuntimeState.CurrentVelocity,bDoubleJumpXYOverride,bDoubleJumpZOverride);
 			ReplicatedMontage_FromAnimStruct(CurrentMovementAnimations.DoubleJumpAnim);
 			OwnerJump.Broadcast(this, false, true);
 		}
 		else
 		{
-			Server_SetMovementMode(EAdvancedMovementMode::EJUMP);
+			SetMovementModeIfChanged(EAdvancedMovementMode::EJUMP);
 			OwnerAsChar->Jump();
+			RecordRpc(ESymplMovementRpc::ECLIENTJUMP);
 			Client_Jump(true);
-			bDidJump = true;
+			RuntimeState.bDidJump = true;
 			OwnerJump.Broadcast(this, false, false);
 		}
 		return;
@@ -599,10 +1926,16 @@ bool USymplAdvancedMovementComponent::Server_AdvancedJump_Validate(bool bPressed
 
 void USymplAdvancedMovementComponent::Server_Landed_Implementation()
 {
+	SYMPL_SCOPE(Server_Landed);
+	if (!AcceptServerRpc(ESymplMovementRpc::ELANDED))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
 	//Reset values.
-	bDidJump = false;
-	DoubleJumpCounter = 0;
-	ClimbTime = 0.f;
+	RuntimeState.bDidJump = false;
+	RuntimeState.DoubleJumpCounter = 0;
+	RuntimeState.ClimbStartTime = -1.f;
 	RestoreLastMovementMode();
 	Server_Blink(false, FVector(), true);
 	Server_SetHovering(false, true);
@@ -612,6 +1945,12 @@ bool USymplAdvancedMovementComponent::Server_Landed_Validate() { return true; }
 
 void USymplAdvancedMovementComponent::Server_Initialize_Implementation()
 {
+	SYMPL_SCOPE(Server_Initialize);
+	if (!AcceptServerRpc(ESymplMovementRpc::EINITIALIZE))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
 	//Set values.
 	OwnerAsChar = Cast<ACharacter>(GetOwner());
 	OwnerAsPawn = Cast<APawn>(GetOwner());
@@ -649,17 +1988,27 @@ void USymplAdvancedMovementComponent::Server_Initialize_Implementation()
 	if (AnimationRow.DataTable)
 	{
 		Server_SetMovementAnimations(*AnimationRow.DataTable->FindRow<FSymplMovementAnimations>(AnimationRow.RowName, ""));
+		if (bWarmUpAnimations)
+		{
+			WarmUpAnimations(CurrentMovementAnimations);
+		}
 	}
-	bInitialized = true;
+	RuntimeState.bInitialized = true;
 }
 
 bool USymplAdvancedMovementComponent::Server_Initialize_Validate() { return true; }
 
 void USymplAdvancedMovementComponent::Server_SetAutoRunEnabled_Implementation(bool bEnabled)
 {
+	SYMPL_SCOPE(Server_SetAutoRunEnabled);
+	if (!AcceptServerRpc(ESymplMovementRpc::ESETAUTORUN))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
 	//Set auto run.
-	Server_SetMovementMode(bEnabled ? EAdvancedMovementMode::ESPRINT : LastMovementMode);
-	bAutoRunEnabled = bEnabled;
+	SetMovementModeIfChanged(bEnabled ? EAdvancedMovementMode::ESPRINT : GetStagedLastMovementMode());
+	RuntimeState.bAutoRunEnabled = bEnabled;
 	AutoRunStateUpdate.Broadcast(this);
 }
 
@@ -668,57 +2017,81 @@ bool USymplAdvancedMovementComponent::Server_SetAutoRunEnabled_Validate(bool bEn
 bool USymplAdvancedMovementComponent::ToggleAutoRunEnabled()
 {
 	//Toggle auto run.
-	bAutoRunEnabled = !bAutoRunEnabled;
+	RuntimeState.bAutoRunEnabled = !RuntimeState.bAutoRunEnabled;
 	return IsAutoRunEnabled();
 }
 
 void USymplAdvancedMovementComponent::Server_FrontCheck_Climb_Implementation(double DeltaTime)
 {
+	SYMPL_SCOPE(Server_FrontCheck_Climb);
+	if (!AcceptServerRpc(ESymplMovementRpc::ECLIMBCHECK))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
 	//Front climb check.
 	ClimbCheck(FrontWallDetect, EMovementAnimType::ECLIMBFRONT, DeltaTime, FVector());
 }
 
-bool USymplAdvancedMovementComponent::Server_FrontCheck_Climb_Validate(double DeltaTime) { return true;}
+bool USymplAdvancedMovementComponent::Server_FrontCheck_Climb_Validate(double DeltaTime) { return FMath::IsFinite(DeltaTime) && DeltaTime >= 0.f; }
 
 void USymplAdvancedMovementComponent::Server_LeftCheck_Climb_Implementation(double DeltaTime)
 {
+	SYMPL_SCOPE(Server_LeftCheck_Climb);
+	if (!AcceptServerRpc(ESymplMovementRpc::ECLIMBCHECK))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
 	//Left climb check.
 	ClimbCheck(LeftWallDetect, EMovementAnimType::ECLIMBLEFT, DeltaTime, FVector());
 }
 
-bool USymplAdvancedMovementComponent::Server_LeftCheck_Climb_Validate(double DeltaTime) { return true;}
+bool USymplAdvancedMovementComponent::Server_LeftCheck_Climb_Validate(double DeltaTime) { return FMath::IsFinite(DeltaTime) && DeltaTime >= 0.f; }
 
 void USymplAdvancedMovementComponent::Server_RightCheck_Climb_Implementation(double DeltaTime)
 {
+	SYMPL_SCOPE(Server_RightCheck_Climb);
+	if (!AcceptServerRpc(ESymplMovementRpc::ECLIMBCHECK))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
 	//Right climb check.
 	ClimbCheck(RightWallDetect, EMovementAnimType::ECLIMBRIGHT, DeltaTime, FVector());
 }
 
-bool USymplAdvancedMovementComponent::Server_RightCheck_Climb_Validate(double DeltaTime) { return true;}
+bool USymplAdvancedMovementComponent::Server_RightCheck_Climb_Validate(double DeltaTime) { return FMath::IsFinite(DeltaTime) && DeltaTime >= 0.f; }
 
 bool USymplAdvancedMovementComponent::FrontClimbCheck(double DeltaTime)
 {
 	//Front climb check on client.
 	Server_FrontCheck_Climb(DeltaTime);
-	return ClimbCheck(FrontWallDetect, EMovementAnimType::ECLIMBFRONT, DeltaTime, FVector(0.f,0.f,WallRun_ClimbLaunchVelocityScalar));
+	return ClimbCheck(FrontWallDetect, EMovementAnimType::ECLIMBFRONT, DeltaTime, FVector(0.f,0.f,GetTuning().WallRun_ClimbLaunchVelocityScalar));
 }
 
 bool USymplAdvancedMovementComponent::LeftClimbCheck(double DeltaTime)
 {
 	//Left climb check on client.
 	Server_LeftCheck_Climb(DeltaTime);
-	return ClimbCheck(LeftWallDetect, EMovementAnimType::ECLIMBLEFT, DeltaTime, LeftWallDetect->GetForwardVector() * WallRun_ClimbLaunchVelocityScalar);
+	return ClimbCheck(LeftWallDetect, EMovementAnimType::ECLIMBLEFT, DeltaTime, LeftWallDetect->GetForwardVector() * GetTuning().WallRun_ClimbLaunchVelocityScalar);
 }
 
 bool USymplAdvancedMovementComponent::RightClimbCheck(double DeltaTime)
 {
 	//Right climb check on client.
 	Server_RightCheck_Climb(DeltaTime);
-	return ClimbCheck(RightWallDetect, EMovementAnimType::ECLIMBRIGHT, DeltaTime, RightWallDetect->GetForwardVector()*WallRun_ClimbLaunchVelocityScalar);
+	return ClimbCheck(RightWallDetect, EMovementAnimType::ECLIMBRIGHT, DeltaTime, RightWallDetect->GetForwardVector()*GetTuning().WallRun_ClimbLaunchVelocityScalar);
 }
 
 void USymplAdvancedMovementComponent::Server_AdvancedCrouch_Implementation(bool bPressed)
 {
+	SYMPL_SCOPE(Server_AdvancedCrouch);
+	if (!AcceptServerRpc(ESymplMovementRpc::EADVANCEDCROUCH))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
 	//Crouch or slide.
 	if (bForceCustomCrouch)
 	{
@@ -731,16 +2104,11 @@ void USymplAdvancedMovementComponent::Server_AdvancedCrouch_Implementation(bool
 		{
 			if (OwnerAsChar)
 			{
-				bSliding = !bSliding;
-				if (bSliding && OwnerAsChar)
-				{
-					LastBrakingFriction = OwnerAsChar->GetCharacterMovement()->BrakingFriction;
-				}
-				Server_SetMovementMode(bSliding ? EAdvancedMovementMode::EJUMP : LastMovementMode);
+				ToggleMovementState(ESymplMovementState::Sliding);
 			}
 			else
 			{
-				Server_SetMovementMode(EAdvancedMovementMode::ECROUCH);
+				SetMovementModeIfChanged(EAdvancedMovementMode::ECROUCH);
 				CustomCrouch(bPressed, true);
 			}
 		}
@@ -752,22 +2120,11 @@ void USymplAdvancedMovementComponent::Server_AdvancedCrouch_Implementation(bool
 		{
 			if (OwnerAsChar)
 			{
-				bCrouching = !bCrouching;
-				Server_SetMovementMode(bCrouching ? EAdvancedMovementMode::ECROUCH : LastMovementMode);
-				if (bCrouching)
-				{
-					OwnerAsChar->Crouch();
-					Client_Crouch(true);
-				}
-				else
-				{
-					OwnerAsChar->UnCrouch();
-					Client_Crouch(false);
-				}
+				ToggleMovementState(ESymplMovementState::Crouching);
 			}
 			else
 			{
-				Server_SetMovementMode(EAdvancedMovementMode::ECROUCH);
+				SetMovementModeIfChanged(EAdvancedMovementMode::ECROUCH);
 				CustomCrouch(bPressed, false);
 			}
 			DidCrouch.Broadcast(this);
@@ -775,14 +2132,11 @@ void USymplAdvancedMovementComponent::Server_AdvancedCrouch_Implementation(bool
 	}
 	else
 	{
-		if (!bToggleCrouch && bCrouching)
+		if (!bToggleCrouch && HasMovementState(ESymplMovementState::Crouching))
 		{
 			if (OwnerAsChar)
 			{
-				RestoreLastMovementMode();
-				OwnerAsChar->UnCrouch();
-				Client_Crouch(false);
-				bCrouching = false;
+				ExitMovementState(ESymplMovementState::Crouching);
 			}
 			else
 			{
@@ -790,12 +2144,11 @@ void USymplAdvancedMovementComponent::Server_AdvancedCrouch_Implementation(bool
 				CustomCrouch(bPressed, false);
 			}
 		}
-		if (!bToggleSlide && bSliding)
+		if (!bToggleSlide && HasMovementState(ESymplMovementState::Sliding))
 		{
 			if (OwnerAsChar)
 			{
-				RestoreLastMovementMode();
-				bSliding = false;
+				ExitMovementState(ESymplMovementState::Sliding);
 			}
 			else
 			{
@@ -817,7 +2170,7 @@ void USymplAdvancedMovementComponent::CustomCrouch_Implementation(bool bPressed,
 void USymplAdvancedMovementComponent::CustomCrouch_Impl(bool bPressed, bool bIsSliding)
 {
 	//Basic crouch.
-	if (bSliding)
+	if (HasMovementState(ESymplMovementState::Sliding))
 	{
 		DidSlide.Broadcast(this);
 	}
@@ -830,107 +2183,325 @@ void USymplAdvancedMovementComponent::CustomCrouch_Impl(bool bPressed, bool bIsS
 bool USymplAdvancedMovementComponent::CanSlide()
 {
 	//Check slide times, angles and velocity.
-	if (!bCanSlide && !bProne)
+	return SymplMovementSimulation::CanSlide(SimConfig, GatherSimState(), GatherSimInput());
+}
+
+void USymplAdvancedMovementComponent::Server_Sprint_Implementation(bool bPressed)
+{
+	SYMPL_SCOPE(Server_Sprint);
+	if (!AcceptServerRpc(ESymplMovementRpc::ESPRINT))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
+	if (bPressed)
+	{
+		if (HasMovementState(ESymplMovementState::Sprinting) || CanSprint())
+		{
+			ToggleMovementState(ESymplMovementState::Sprinting);
+		}
+	}
+	else
+	{
+		if (!bToggleSprint)
+		{
+			ExitMovementState(ESymplMovementState::Sprinting);
+		}
+	}
+}
+
+bool USymplAdvancedMovementComponent::Server_Sprint_Validate(bool bPressed) { return true; }
+
+void USymplAdvancedMovementComponent::Server_SetMovementMode_Implementation(EAdvancedMovementMode Mode)
+{
+	SYMPL_SCOPE(Server_SetMovementMode);
+	if (!AcceptServerRpc(ESymplMovementRpc::ESETMOVEMENTMODE))
+	{
+		return;
+	}
+	//Nothing to do.
+	const EAdvancedMovementMode staged = GetStagedMovementMode();
+	if (Mode == staged)
+	{
+		return;
+	}
+	//Stage the change. It is committed once at the end of the tick.
+	PendingLastMovementMode = staged;
+	PendingMovementMode = Mode;
+	bHasPendingMovementMode = true;
+	bHasPendingLastMovementMode = false;
+}
+
+bool USymplAdvancedMovementComponent::Server_SetMovementMode_Validate(EAdvancedMovementMode Mode) { return Mode <= EAdvancedMovementMode::EJETPACK; }
+
+void USymplAdvancedMovementComponent::Server_SetMovementSpeeds_Implementation(const TArray<FSymplMovementSpeeds>& InSpeeds, EAdvancedMovementMode NewMode, bool bForceSetMovementMode)
+{
+	SYMPL_SCOPE(Server_SetMovementSpeeds);
+	if (!AcceptServerRpc(ESymplMovementRpc::ESETMOVEMENTSPEEDS))
+	{
+		return;
+	}
+	//Don't let clients give themselves speeds the project doesn't allow.
+	if (IsClientServerRpc())
+	{
+		const double maxSpeed = GetDefault<USymplAdvancedMovementSettings>()->MaxClientMovementSpeed;
+		for (auto& speed : InSpeeds)
+		{
+			if (speed.Speed > maxSpeed)
+			{
+				RejectServerRpc(ESymplMovementRpc::ESETMOVEMENTSPEEDS);
+				return;
+			}
+		}
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
+	SelectedSpeeds = InSpeeds;
+	if (bForceSetMovementMode)
+	{
+		Server_SetMovementMode(NewMode);
+	}
+	SelectedSpeedsUpdate.Broadcast(this);
+}
+
+bool USymplAdvancedMovementComponent::Server_SetMovementSpeeds_Validate(const TArray<FSymplMovementSpeeds>& InSpeeds, EAdvancedMovementMode NewMode, bool bForceSetMovementMode)
+{
+	if (NewMode > EAdvancedMovementMode::EJETPACK || InSpeeds.Num() > 64)
 	{
 		return false;
 	}
-	if (MaxSlideTime >= 0.f)
+	for (auto& speed : InSpeeds)
 	{
-		if (SlideTime >= MaxSlideTime)
+		if (!FMath::IsFinite(speed.Speed) || speed.Speed < 0.f)
 		{
 			return false;
 		}
 	}
-	double velocity = CurrentVelocity.Size();
-	if (velocity >= RequiredSlideSpeed)
+	return true;
+}
+
+void USymplAdvancedMovementComponent::RestoreLastMovementMode()
+{
+	SetMovementModeIfChanged(GetStagedLastMovementMode());
+}
+
+void USymplAdvancedMovementComponent::SetMovementModeIfChanged(EAdvancedMovementMode Mode)
+{
+	//Skip the rpc when the mode wouldn't change.
+	if (Mode != GetStagedMovementMode())
+	{
+		Server_SetMovementMode(Mode);
+	}
+}
+
+void USymplAdvancedMovementComponent::CommitMovementMode()
+{
+	if (!bHasPendingMovementMode)
+	{
+		return;
+	}
+	const bool bUsePendingLast = bHasPendingLastMovementMode;
+	bHasPendingMovementMode = false;
+	bHasPendingLastMovementMode = false;
+	//The frame came back to the mode it started with.
+	if (PendingMovementMode == RuntimeState.CurrentMovementMode)
+	{
+		return;
+	}
+	const EAdvancedMovementMode from = RuntimeState.CurrentMovementMode;
+	RuntimeState.LastMovementMode = bUsePendingLast ? PendingLastMovementMode.GetValue() : from;
+	RuntimeState.CurrentMovementMode = PendingMovementMode;
+	RefreshSimConfig();
+	if (RollbackDepth == 0)
+	{
+		MovementModeUpdate.Broadcast(this);
+		MovementModeTransition.Broadcast(this, from, RuntimeState.CurrentMovementMode);
+	}
+}
+
+bool USymplAdvancedMovementComponent::EnterMovementState(ESymplMovementState State)
+{
+	if (HasMovementState(State))
+	{
+		return true;
+	}
+	const ESymplMovementSimFlags flags = GetMovementState();
+	if (!SymplMovementStateMachine::CanEnter(flags, State))
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("%s: Can't enter movement state %s from %u."), *GetNameSafe(GetOwner()), SymplMovementStateMachine::GetStateName(State), (uint32)flags);
+		return false;
+	}
+	//Remember where to go back to once every state has exited.
+	if (ModeStack.IsEmpty())
+	{
+		ModeStack.BaseMode = GetStagedMovementMode();
+	}
+	//Exit everything this state excludes. Their entries come off the mode stack, but the new state sets the mode, so they don't restore it.
+	const ESymplMovementSimFlags exits = SymplMovementStateMachine::GetExits(flags, State);
+	if (exits != ESymplMovementSimFlags::None)
+	{
+		for (int32 i = 0; i < (int32)ESymplMovementState::Max; i++)
+		{
+			if (SymplMovementStateMachine::IsActive(exits, (ESymplMovementState)i))
+			{
+				ExitMovementState((ESymplMovementState)i, false);
+			}
+		}
+	}
+	//The mode the excluded states unwind to.
+	const EAdvancedMovementMode unwoundMode = ModeStack.GetMode();
+	const FSymplMovementStateRule& rule = SymplMovementStateMachine::GetRule(State);
+	RuntimeState.MovementStateFlags |= (uint32)rule.Flag;
+	RefreshSimConfig();
+	//Timers only replicate when they start and stop.
+	if (double* startTime = GetStateStartTime(State))
+	{
+		*startTime = GetServerWorldTime();
+	}
+	OnEnterMovementState(State);
+	if (rule.Mode != EAdvancedMovementMode::ENONE)
+	{
+		ModeStack.Push(State, rule.Mode);
+		SetMovementModeIfChanged(rule.Mode);
+	}
+	else if (exits != ESymplMovementSimFlags::None)
+	{
+		SetMovementModeIfChanged(unwoundMode);
+	}
+	//The excluded states are gone, so a restore must not go back to their mode.
+	if (exits != ESymplMovementSimFlags::None && bHasPendingMovementMode && unwoundMode != PendingMovementMode)
 	{
-		if (bIgnoreSlideAngle)
-		{
-			return true;
-		}
-		if (!OwnerAsChar->GetCharacterMovement()->IsFalling())
-		{
-			double angle = OwnerAsChar->GetCharacterMovement()->CurrentFloor.HitResult.ImpactNormal.Dot(FVector(0.f, 0.f, 1.f));
-			angle = UKismetMathLibrary::DegAcos(angle);
-			return angle >= RequiredSlideAngle;
-		}
+		PendingLastMovementMode = unwoundMode;
+		bHasPendingLastMovementMode = true;
 	}
-	return false;
+	return true;
 }
 
-void USymplAdvancedMovementComponent::Server_Sprint_Implementation(bool bPressed)
+void USymplAdvancedMovementComponent::ExitMovementState(ESymplMovementState State, bool bRestoreMode)
 {
-	if (bPressed)
+	if (!HasMovementState(State))
 	{
-		bSprinting = !bSprinting;
-		Server_SetMovementMode(bSprinting ? EAdvancedMovementMode::ESPRINT : LastMovementMode);
+		return;
 	}
-	else
+	const FSymplMovementStateRule& rule = SymplMovementStateMachine::GetRule(State);
+	RuntimeState.MovementStateFlags &= ~(uint32)rule.Flag;
+	RefreshSimConfig();
+	ModeStack.Remove(State);
+	if (double* startTime = GetStateStartTime(State))
 	{
-		if (!bToggleSprint)
-		{
-			RestoreLastMovementMode();
-			bSprinting = false;
-		}
+		*startTime = -1.f;
+	}
+	OnExitMovementState(State);
+	//Go back to the next state down, not just the last mode, so nested states unwind in order.
+	if (bRestoreMode && rule.bRestoreModeOnExit)
+	{
+		SetMovementModeIfChanged(ModeStack.GetMode());
 	}
 }
 
-bool USymplAdvancedMovementComponent::Server_Sprint_Validate(bool bPressed) { return true; }
-
-void USymplAdvancedMovementComponent::Server_SetMovementMode_Implementation(EAdvancedMovementMode Mode)
+double* USymplAdvancedMovementComponent::GetStateStartTime(ESymplMovementState State)
 {
-	LastMovementMode = CurrentMovementMode;
-	CurrentMovementMode = Mode;
-	MovementModeUpdate.Broadcast(this);
+	switch (State)
+	{
+	case ESymplMovementState::Dashing: return &RuntimeState.DashStartTime;
+	case ESymplMovementState::Blinking: return &RuntimeState.BlinkStartTime;
+	case ESymplMovementState::Rolling: return &RuntimeState.RollStartTime;
+	case ESymplMovementState::Hovering: return &RuntimeState.HoverStartTime;
+	case ESymplMovementState::Sliding: return &RuntimeState.SlideStartTime;
+	default: return nullptr;
+	}
 }
 
-bool USymplAdvancedMovementComponent::Server_SetMovementMode_Validate(EAdvancedMovementMode Mode) { return true; }
-
-void USymplAdvancedMovementComponent::Server_SetMovementSpeeds_Implementation(const TArray<FSymplMovementSpeeds>& InSpeeds, EAdvancedMovementMode NewMode, bool bForceSetMovementMode)
+bool USymplAdvancedMovementComponent::ToggleMovementState(ESymplMovementState State)
 {
-	SelectedSpeeds = InSpeeds;
-	if (bForceSetMovementMode)
+	if (HasMovementState(State))
 	{
-		Server_SetMovementMode(NewMode);
+		ExitMovementState(State);
+		return false;
 	}
-	SelectedSpeedsUpdate.Broadcast(this);
+	return EnterMovementState(State);
 }
 
-bool USymplAdvancedMovementComponent::Server_SetMovementSpeeds_Validate(const TArray<FSymplMovementSpeeds>& InSpeeds, EAdvancedMovementMode NewMode, bool bForceSetMovementMode) { return true; }
-
-void USymplAdvancedMovementComponent::RestoreLastMovementMode()
+void USymplAdvancedMovementComponent::OnEnterMovementState(ESymplMovementState State)
 {
-	Server_SetMovementMode(LastMovementMode);
+	if (!OwnerAsChar)
+	{
+		return;
+	}
+	switch (State)
+	{
+	case ESymplMovementState::Sliding:
+		LastBrakingFriction = OwnerAsChar->GetCharacterMovement()->BrakingFriction;
+		break;
+	case ESymplMovementState::Crouching:
+		OwnerAsChar->Crouch();
+		if (RollbackDepth == 0)
+		{
+			RecordRpc(ESymplMovementRpc::ECLIENTCROUCH);
+			Client_Crouch(true);
+		}
+		break;
+	case ESymplMovementState::Prone:
+		// Set the character's capsule height and radius to simulate going prone
+		OwnerAsChar->GetCapsuleComponent()->SetCapsuleSize(40.f, 20.f);
+		OwnerAsChar->GetMesh()->SetRelativeLocation(FVector(0.f, 0.f, -40.f));
+		break;
+	case ESymplMovementState::Hovering:
+		LastCharacterMovementMode = OwnerAsChar->GetCharacterMovement()->MovementMode;
+		OwnerAsChar->GetCharacterMovement()->SetMovementMode(MOVE_Flying);
+		break;
+	default:
+		break;
+	}
 }
 
-void USymplAdvancedMovementComponent::Server_SetProne_Implementation(bool bPressed)
+void USymplAdvancedMovementComponent::OnExitMovementState(ESymplMovementState State)
 {
-	if (bPressed)
+	switch (State)
 	{
-		bProne = !bProne;
-		Server_SetMovementMode(bProne ? EAdvancedMovementMode::EPRONE : LastMovementMode);
-		if (bProne)
+	case ESymplMovementState::Crouching:
+		if (OwnerAsChar)
 		{
-			if (OwnerAsChar)
+			OwnerAsChar->UnCrouch();
+			if (RollbackDepth == 0)
 			{
-				// Set the character's capsule height and radius to simulate going prone
-				OwnerAsChar->GetCapsuleComponent()->SetCapsuleSize(40.f, 20.f);
-				OwnerAsChar->GetMesh()->SetRelativeLocation(FVector(0.f, 0.f, -40.f));
+				RecordRpc(ESymplMovementRpc::ECLIENTCROUCH);
+				Client_Crouch(false);
 			}
 		}
+		break;
+	case ESymplMovementState::Prone:
+		if (OwnerAsChar)
+		{
+			// Restore the character's capsule height and radius
+			OwnerAsChar->GetCapsuleComponent()->SetCapsuleSize(DefaultCapsuleSize.X,DefaultCapsuleSize.Y);
+			OwnerAsChar->GetMesh()->SetRelativeLocation(DefaultMeshLocation);
+		}
+		break;
+	case ESymplMovementState::Hovering:
+		RestoreLastCharacterMovementMode();
+		break;
+	default:
+		break;
+	}
+}
+
+void USymplAdvancedMovementComponent::Server_SetProne_Implementation(bool bPressed)
+{
+	SYMPL_SCOPE(Server_SetProne);
+	if (!AcceptServerRpc(ESymplMovementRpc::ESETPRONE))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
+	if (bPressed)
+	{
+		ToggleMovementState(ESymplMovementState::Prone);
 	}
 	else
 	{
 		if (!bToggleProne)
 		{
-			RestoreLastMovementMode();
-			bProne = false;
-			if (OwnerAsChar)
-			{
-				// Set the character's capsule height and radius to simulate going prone
-				OwnerAsChar->GetCapsuleComponent()->SetCapsuleSize(DefaultCapsuleSize.X,DefaultCapsuleSize.Y);
-				OwnerAsChar->GetMesh()->SetRelativeLocation(DefaultMeshLocation);
-			}
+			ExitMovementState(ESymplMovementState::Prone);
 		}
 	}
 	DidProne.Broadcast(this);
@@ -940,66 +2511,165 @@ bool USymplAdvancedMovementComponent::Server_SetProne_Validate(bool bPressed) {
 
 void USymplAdvancedMovementComponent::Server_Dash_Implementation(bool bPressed, FVector Direction, bool bForceEnd)
 {
+	SYMPL_SCOPE(Server_Dash);
+	if (!AcceptServerRpc(ESymplMovementRpc::EDASH))
+	{
+		return;
+	}
+	//Clients check charges before sending, so a press without one is stale or forged.
+	if (bPressed && !HasMovementState(ESymplMovementState::Dashing) && IsClientServerRpc() && !HasAbilityCharge(DashCharges, GetTuning().DashChargeCooldown))
+	{
+		RejectServerRpc(ESymplMovementRpc::EDASH);
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
 	if (bPressed && CanDash())
 	{
-		bDashing = !bDashing;
-		Server_SetMovementMode(bDashing ? EAdvancedMovementMode::EDASH : LastMovementMode);
-		CurrentDashDirection = Direction;
+		if (ToggleMovementState(ESymplMovementState::Dashing))
+		{
+			SpendAbilityCharge(DashCharges, GetTuning().MaxDashCharges, GetTuning().DashChargeCooldown);
+		}
+		RuntimeState.CurrentDashDirection = Direction.GetClampedToMaxSize(1.f);
 	}
 	else
 	{
 		if (!bToggleDash || bForceEnd)
 		{
-			bDashing = false;
-			RestoreLastMovementMode();
+			ExitMovementState(ESymplMovementState::Dashing);
 		}
 	}
 	DidDash.Broadcast(this);
 }
 
-bool USymplAdvancedMovementComponent::Server_Dash_Validate(bool bPressed, FVector Direction, bool bForceEnd) { return true; }
+bool USymplAdvancedMovementComponent::Server_Dash_Validate(bool bPressed, FVector Direction, bool bForceEnd) { return !Direction.ContainsNaN(); }
 
-void USymplAdvancedMovementComponent::Server_Blink_Implementation(bool bPressed, FVector Direction, bool bForceEnd)
+void USymplAdvancedMovementComponent::Server_Blink_Implementation(bool bPressed, FVector Direction, bool bForceEnd, double ClientTime)
 {
+	SYMPL_SCOPE(Server_Blink);
+	if (!AcceptServerRpc(ESymplMovementRpc::EBLINK))
+	{
+		return;
+	}
+	//Clients check charges before sending, so a press without one is stale or forged.
+	if (bPressed && !HasMovementState(ESymplMovementState::Blinking) && IsClientServerRpc() && !HasAbilityCharge(BlinkCharges, GetTuning().BlinkChargeCooldown))
+	{
+		RejectServerRpc(ESymplMovementRpc::EBLINK);
+		return;
+	}
+	//Make sure the client wasn't blinking into a wall.
+	if (bPressed && !HasMovementState(ESymplMovementState::Blinking) && IsClientServerRpc() && !ValidateClientBlink(Direction, ClientTime))
+	{
+		RejectServerRpc(ESymplMovementRpc::EBLINK);
+		SendMovementCorrection();
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
 	if (bPressed && CanBlink())
 	{
-		bBlinking = !bBlinking;
-		Server_SetMovementMode(bBlinking ? EAdvancedMovementMode::EBLINK : LastMovementMode);
-		CurrentBlinkDirection = Direction;
+		if (ToggleMovementState(ESymplMovementState::Blinking))
+		{
+			SpendAbilityCharge(BlinkCharges, GetTuning().MaxBlinkCharges, GetTuning().BlinkChargeCooldown);
+		}
+		RuntimeState.CurrentBlinkDirection = Direction.GetClampedToMaxSize(1.f);
 	}
 	else
 	{
 		if (!bToggleBlink || bForceEnd)
 		{
-			bBlinking = false;
-			RestoreLastMovementMode();
+			ExitMovementState(ESymplMovementState::Blinking);
 		}
 	}
 	DidBlink.Broadcast(this);
 }
 
-bool USymplAdvancedMovementComponent::Server_Blink_Validate(bool bPressed, FVector Direction, bool bForceEnd) { return true; }
+bool USymplAdvancedMovementComponent::Server_Blink_Validate(bool bPressed, FVector Direction, bool bForceEnd, double ClientTime) { return !Direction.ContainsNaN() && FMath::IsFinite(ClientTime); }
 
 void USymplAdvancedMovementComponent::Server_Roll_Implementation(bool bPressed, FVector Direction, bool bForceEnd)
 {
+	SYMPL_SCOPE(Server_Roll);
+	if (!AcceptServerRpc(ESymplMovementRpc::EROLL))
+	{
+		return;
+	}
+	//Clients check charges before sending, so a press without one is stale or forged.
+	if (bPressed && !HasMovementState(ESymplMovementState::Rolling) && IsClientServerRpc() && !HasAbilityCharge(RollCharges, GetTuning().RollChargeCooldown))
+	{
+		RejectServerRpc(ESymplMovementRpc::EROLL);
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
 	if (bPressed && CanRoll())
 	{
-		bRolling = !bRolling;
-		Server_SetMovementMode(bRolling ? EAdvancedMovementMode::EROLL : LastMovementMode);
-		CurrentRollDirection = Direction;
+		if (ToggleMovementState(ESymplMovementState::Rolling))
+		{
+			SpendAbilityCharge(RollCharges, GetTuning().MaxRollCharges, GetTuning().RollChargeCooldown);
+		}
+		RuntimeState.CurrentRollDirection = Direction.GetClampedToMaxSize(1.f);
 	}
 	else
 	{
 		if (!bToggleRoll || bForceEnd)
 		{
-			bRolling = false;
-			RestoreLastMovementMode();
+			ExitMovementState(ESymplMovementState::Rolling);
 		}
 	}
 	DidRoll.Broadcast(this);
 }
 
-bool USymplAdvancedMovementComponent::Server_Roll_Validate(bool bPressed, FVector Direction, bool bForceEnd) { return true; }
+bool USymplAdvancedMovementComponent::Server_Roll_Validate(bool bPressed, FVector Direction, bool bForceEnd) { return !Direction.ContainsNaN(); }
+
+bool USymplAdvancedMovementComponent::TryDash(bool bPressed, FVector Direction)
+{
+	//Releases always go through, the press they end may not have replicated back yet.
+	if (bPressed && !HasMovementState(ESymplMovementState::Dashing) && !CanDash())
+	{
+		return false;
+	}
+	Server_Dash(bPressed, Direction, false);
+	return true;
+}
+
+bool USymplAdvancedMovementComponent::TryBlink(bool bPressed, FVector Direction)
+{
+	if (bPressed && !HasMovementState(ESymplMovementState::Blinking) && !CanBlink())
+	{
+		return false;
+	}
+	Server_Blink(bPressed, Direction, false, GetServerWorldTime());
+	return true;
+}
+
+bool USymplAdvancedMovementComponent::TryRoll(bool bPressed, FVector Direction)
+{
+	if (bPressed && !HasMovementState(ESymplMovementState::Rolling) && !CanRoll())
+	{
+		return false;
+	}
+	Server_Roll(bPressed, Direction, false);
+	return true;
+}
+
+void USymplAdvancedMovementComponent::SpendAbilityCharge(FSymplResourceMeter& Charges, int32 MaxCharges, double Cooldown)
+{
+	if (Cooldown <= 0.f)
+	{
+		return;
+	}
+	//Pick up tuning changes. The meter clamps at max, so the rate never has to change again.
+	const double time = GetServerWorldTime();
+	Charges.SetMaxValue(time, FMath::Max(MaxCharges, 1));
+	Charges.SetRate(time, 1.f / Cooldown);
+	Charges.Add(time, -1.f);
+}
+
+FSymplResourceMeter USymplAdvancedMovementComponent::MakeAbilityCharges(int32 MaxCharges, double Cooldown, double Time)
+{
+	const double maxCharges = FMath::Max(MaxCharges, 1);
+	FSymplResourceMeter charges(maxCharges, maxCharges);
+	charges.Rate = Cooldown > 0.f ? 1.f / Cooldown : 0.f;
+	charges.BaseTime = Time;
+	return charges;
+}
 
 void USymplAdvancedMovementComponent::Server_SetMovementAnimations(FSymplMovementAnimations Animations)
 {
@@ -1023,16 +2693,29 @@ double USymplAdvancedMovementComponent::ReplicatedMontage(UAnimMontage* Montage,
 void USymplAdvancedMovementComponent::Server_PlayMontage_Implementation(UAnimMontage* Montage, bool bUseAnimInstance, double PlayRate, 
 	double StartPosition, bool bStopMontages, FName StartSectionName)
 {
+	SYMPL_SCOPE(Server_PlayMontage);
+	if (!AcceptServerRpc(ESymplMovementRpc::EPLAYMONTAGE))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
+	RecordRpc(ESymplMovementRpc::EPLAYMONTAGEMULTICAST);
 	Multicast_PlayMontage(Montage, bUseAnimInstance, PlayRate, StartPosition, bStopMontages, StartSectionName);
 }
 
 bool USymplAdvancedMovementComponent::Server_PlayMontage_Validate(UAnimMontage* Montage, bool bUseAnimInstance, double PlayRate, 
-	double StartPosition, bool bStopMontages, FName StartSectionName) { return true; }
+	double StartPosition, bool bStopMontages, FName StartSectionName)
+{
+	return FMath::IsFinite(PlayRate) && PlayRate > 0.f && PlayRate <= 10.f && FMath::IsFinite(StartPosition) && StartPosition >= 0.f;
+}
 
 void USymplAdvancedMovementComponent::Multicast_PlayMontage_Implementation(UAnimMontage* Montage, bool bUseAnimInstance, 
 	double PlayRate, double StartPosition, bool bStopMontages, FName StartSectionName)
 {
-	if (!Montage)
+	SYMPL_SCOPE(Multicast_PlayMontage);
+	SYMPL_COUNT(MulticastRpcs, 1);
+	//Nobody can see this owner, skip the montage.
+	if (!Montage || bLowSignificance)
 	{
 		return;
 	}
@@ -1060,34 +2743,71 @@ double USymplAdvancedMovementComponent::ReplicatedMontage_FromAnimStruct(FSymplM
 	return ReplicatedMontage(montage, Anim.bStopMontages, Anim.PlayRate, Anim.StartPosition, Anim.bStopMontages, Anim.StartSectionName);
 }
 
-void USymplAdvancedMovementComponent::Server_SetHovering_Implementation(bool bPressed, bool bForceEndHover)
+void USymplAdvancedMovementComponent::WarmUpAnimations(const FSymplMovementAnimations& Animations)
 {
-	if (bPressed)
+	//Gather every unique animation in the struct.
+	TArray<UAnimSequenceBase*> anims;
+	auto addAnim = [&anims](UAnimSequenceBase* Anim)
 	{
-		bHovering = !bHovering;
-		if(bHovering)
+		if (Anim)
 		{
-			if (OwnerAsChar)
-			{
-				LastCharacterMovementMode = OwnerAsChar->GetCharacterMovement()->MovementMode;
-				OwnerAsChar->GetCharacterMovement()->SetMovementMode(MOVE_Flying);
-			}
-			Server_SetMovementMode(EAdvancedMovementMode::EHOVER);
+			anims.AddUnique(Anim);
+		}
+	};
+	for (auto& anim : Animations.DashAnims) { addAnim(anim.Value.Anim); }
+	for (auto& anim : Animations.BlinkAnims) { addAnim(anim.Value.Anim); }
+	for (auto& anim : Animations.RollAnims) { addAnim(anim.Value.Anim); }
+	for (auto& anim : Animations.WallRunAnims) { addAnim(anim.Value.Anim); }
+	for (const TMap<TEnumAsByte<EAdvancedMovementMode>, FSymplMovementModeAnimation>* modeAnims : { &Animations.MovementAnims, &Animations.ParachuteAnims })
+	{
+		for (auto& anim : *modeAnims)
+		{
+			addAnim(anim.Value.WalkAnim);
+			addAnim(anim.Value.JumpStartAnim);
+			addAnim(anim.Value.JumpLoopAnim);
+			addAnim(anim.Value.JumpEndAnim);
+			addAnim(anim.Value.CrouchAnim);
+			addAnim(anim.Value.SprintAnim);
 		}
 	}
+	addAnim(Animations.ProneAnim.Anim);
+	addAnim(Animations.SlideAnim.Anim);
+	addAnim(Animations.DoubleJumpAnim.Anim);
+	addAnim(Animations.ParachuteAnim.Anim);
+
+	//Request them as one batch. Anything not yet loaded, including notify assets, loads in the background without a game thread flush.
+	TArray<FSoftObjectPath> paths;
+	paths.Reserve(anims.Num());
+	for (UAnimSequenceBase* anim : anims)
+	{
+		paths.Add(FSoftObjectPath(anim));
+	}
+	if (AnimationWarmUpHandle.IsValid())
+	{
+		AnimationWarmUpHandle->ReleaseHandle();
+	}
+	AnimationWarmUpHandle = paths.Num() > 0 ? UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(paths), FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority) : nullptr;
+}
+
+void USymplAdvancedMovementComponent::Server_SetHovering_Implementation(bool bPressed, bool bForceEndHover)
+{
+	SYMPL_SCOPE(Server_SetHovering);
+	if (!AcceptServerRpc(ESymplMovementRpc::ESETHOVERING))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
+	if (bPressed)
+	{
+		ToggleMovementState(ESymplMovementState::Hovering);
+	}
 	else
 	{
 		if (!bToggleHover || bForceEndHover)
 		{
-			bHovering = false;
+			ExitMovementState(ESymplMovementState::Hovering);
 		}
 	}
-	if (!bHovering)
-	{
-		HoverTime = 0.f;
-		RestoreLastMovementMode();
-		RestoreLastCharacterMovementMode();
-	}
 	DidHover.Broadcast(this);
 }
 
@@ -1106,7 +2826,17 @@ void USymplAdvancedMovementComponent::RestoreLastCharacterMovementMode()
 
 void USymplAdvancedMovementComponent::Server_DeployParachute_Implementation()
 {
-	Server_SetMovementMode(EAdvancedMovementMode::EPARACHUTE);
+	SYMPL_SCOPE(Server_DeployParachute);
+	if (!AcceptServerRpc(ESymplMovementRpc::EDEPLOYPARACHUTE))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
+	//Already deployed, or the transition table doesn't allow it.
+	if (HasMovementState(ESymplMovementState::Parachuting) || !EnterMovementState(ESymplMovementState::Parachuting))
+	{
+		return;
+	}
 	if (OwnerAsChar)
 	{
 		LastMaxAcceleration = OwnerAsChar->GetCharacterMovement()->MaxAcceleration;
@@ -1115,27 +2845,44 @@ void USymplAdvancedMovementComponent::Server_DeployParachute_Implementation()
 		OwnerAsChar->GetCharacterMovement()->DisableMovement();
 
 		// Spawn parachute actor and attach it to character
-		if (ParachuteClass)
-		{
-			FActorSpawnParameters SpawnParams;
-			SpawnParams.Owner = OwnerRef;
-			SpawnParams.Instigator = OwnerAsChar;
-
-			FAttachmentTransformRules AttachRules(EAttachmentRule::SnapToTarget, true);
-
-			ParachuteActor = GetWorld()->SpawnActor<AActor>(ParachuteClass.LoadSynchronous(), SpawnParams);
-			ParachuteActor->AttachToComponent(OwnerAsChar->GetMesh(), AttachRules, ParachuteAttachSocket);
-		}
+		SpawnParachuteActor();
 
 		ReplicatedMontage_FromAnimStruct(CurrentMovementAnimations.ParachuteAnim);
 
-		// Enable parachute control and camera
-		bIsParachuting = true;
-
 		// Adjust character movement properties for parachute descent
 		OwnerAsChar->GetCharacterMovement()->SetMovementMode(MOVE_Falling);
-		OwnerAsChar->GetCharacterMovement()->MaxAcceleration = ParachuteMaxAcceleration;
+		OwnerAsChar->GetCharacterMovement()->MaxAcceleration = GetTuning().ParachuteMaxAcceleration;
+	}
+}
+
+void USymplAdvancedMovementComponent::SpawnParachuteActor()
+{
+	if (ParachuteActor || !ParachuteClass || !OwnerAsChar || GetOwnerRole() != ROLE_Authority)
+	{
+		return;
+	}
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = OwnerRef;
+	SpawnParams.Instigator = OwnerAsChar;
+
+	FAttachmentTransformRules AttachRules(EAttachmentRule::SnapToTarget, true);
+
+	ParachuteActor = GetWorld()->SpawnActor<AActor>(ParachuteClass.LoadSynchronous(), SpawnParams);
+	if (ParachuteActor)
+	{
+		ParachuteActor->AttachToComponent(OwnerAsChar->GetMesh(), AttachRules, ParachuteAttachSocket);
+	}
+}
+
+void USymplAdvancedMovementComponent::DestroyParachuteActor()
+{
+	if (!ParachuteActor || GetOwnerRole() != ROLE_Authority)
+	{
+		return;
 	}
+	ParachuteActor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	ParachuteActor->Destroy();
+	ParachuteActor = nullptr;
 }
 
 bool USymplAdvancedMovementComponent::Server_DeployParachute_Validate()
@@ -1145,23 +2892,22 @@ bool USymplAdvancedMovementComponent::Server_DeployParachute_Validate()
 
 void USymplAdvancedMovementComponent::Server_ReleaseParachute_Implementation()
 {
+	SYMPL_SCOPE(Server_ReleaseParachute);
+	if (!AcceptServerRpc(ESymplMovementRpc::ERELEASEPARACHUTE))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
+	const bool bWasParachuting = HasMovementState(ESymplMovementState::Parachuting);
 	RestoreLastCharacterMovementMode();
-	RestoreLastMovementMode();
+	ExitMovementState(ESymplMovementState::Parachuting);
 	if (OwnerAsChar)
 	{
 		// Detach and destroy parachute actor
-		if (ParachuteActor)
-		{
-			ParachuteActor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
-			ParachuteActor->Destroy();
-			ParachuteActor = nullptr;
-		}
+		DestroyParachuteActor();
 
-		if (OwnerAsChar && bIsParachuting)
+		if (bWasParachuting)
 		{
-			// Disable parachute control
-			bIsParachuting = false;
-
 			// Adjust character movement properties back to normal
 			OwnerAsChar->GetCharacterMovement()->MaxAcceleration = LastMaxAcceleration;
 		}
@@ -1175,11 +2921,12 @@ bool USymplAdvancedMovementComponent::CanDeployParachute()
 	FHitResult hit;
 	if (!FindFloor(hit))
 		return true;
-	return hit.Distance >= RequiredDistanceToDeployParachute;
+	return hit.Distance >= GetTuning().RequiredDistanceToDeployParachute;
 }
 
 bool USymplAdvancedMovementComponent::FindFloor(FHitResult& OutHit)
 {
+	SYMPL_SCOPE(FindFloor);
 	if (OwnerAsChar)
 	{
 		OutHit = OwnerAsChar->GetCharacterMovement()->CurrentFloor.HitResult;
@@ -1193,30 +2940,49 @@ bool USymplAdvancedMovementComponent::FindFloor(FHitResult& OutHit)
 		shape.MakeSphere(1.f);
 		FCollisionQueryParams params;
 		FCollisionResponseParams response;
-		return GetWorld()->SweepSingleByChannel(OutHit, loc, loc + (dir * FloorCheckDistance), FQuat(), FloorTraceChannel, shape, params, response);
+		SYMPL_COUNT(Traces, 1);
+		return GetWorld()->SweepSingleByChannel(OutHit, loc, loc + (dir * GetTuning().FloorCheckDistance), FQuat(), FloorTraceChannel, shape, params, response);
 	}
 }
 
 void USymplAdvancedMovementComponent::Server_SetForwardInput_Implementation(double Value)
 {
-	ForwardInput = Value;
+	SYMPL_SCOPE(Server_SetForwardInput);
+	if (!AcceptServerRpc(ESymplMovementRpc::ESETINPUT))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
+	RuntimeState.ForwardInput = FMath::Clamp(Value, -1.0, 1.0);
 }
 
-bool USymplAdvancedMovementComponent::Server_SetForwardInput_Validate(double Value) { return true; }
+bool USymplAdvancedMovementComponent::Server_SetForwardInput_Validate(double Value) { return FMath::IsFinite(Value); }
 
 void USymplAdvancedMovementComponent::Server_SetRightInput_Implementation(double Value)
 {
-	RightInput = Value;
+	SYMPL_SCOPE(Server_SetRightInput);
+	if (!AcceptServerRpc(ESymplMovementRpc::ESETINPUT))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
+	RuntimeState.RightInput = FMath::Clamp(Value, -1.0, 1.0);
 }
 
-bool USymplAdvancedMovementComponent::Server_SetRightInput_Validate(double Value) { return true; }
+bool USymplAdvancedMovementComponent::Server_SetRightInput_Validate(double Value) { return FMath::IsFinite(Value); }
 
 void USymplAdvancedMovementComponent::Server_SetUpInput_Implementation(double Value)
 {
-	UpInput = Value;
+	SYMPL_SCOPE(Server_SetUpInput);
+	if (!AcceptServerRpc(ESymplMovementRpc::ESETINPUT))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
+	RuntimeState.UpInput = FMath::Clamp(Value, -1.0, 1.0);
 }
 
-bool USymplAdvancedMovementComponent::Server_SetUpInput_Validate(double Value) { return true; }
+bool USymplAdvancedMovementComponent::Server_SetUpInput_Validate(double Value) { return FMath::IsFinite(Value); }
 
 void USymplAdvancedMovementComponent::AdvancedMovementInput_Forward(double Value, bool bForce)
 {
@@ -1224,7 +2990,7 @@ void USymplAdvancedMovementComponent::AdvancedMovementInput_Forward(double Value
 	{
 		return;
 	}
-	ForwardInput = Value;
+	RuntimeState.ForwardInput = Value;
 	Server_SetForwardInput(Value);
 	if (OwnerAsPawn)
 	{
@@ -1242,7 +3008,7 @@ void USymplAdvancedMovementComponent::AdvancedMovementInput_Right(double Value,
 	{
 		return;
 	}
-	RightInput = Value;
+	RuntimeState.RightInput = Value;
 	Server_SetRightInput(Value);
 	if (OwnerAsPawn)
 	{
@@ -1260,7 +3026,7 @@ void USymplAdvancedMovementComponent::AdvancedMovementInput_Up(double Value, boo
 	{
 		return;
 	}
-	UpInput = Value;
+	RuntimeState.UpInput = Value;
 	Server_SetUpInput(Value);
 	if (OwnerAsPawn)
 	{
@@ -1274,14 +3040,19 @@ void USymplAdvancedMovementComponent::AdvancedMovementInput_Up(double Value, boo
 
 void USymplAdvancedMovementComponent::Server_SetZeroGMovement_Implementation(bool bZeroG)
 {
-	bZeroGMovement = bZeroG;
-	if (bZeroGMovement)
+	SYMPL_SCOPE(Server_SetZeroGMovement);
+	if (!AcceptServerRpc(ESymplMovementRpc::ESETZEROG))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
+	if (bZeroG)
 	{
-		Server_SetMovementMode(EAdvancedMovementMode::EZEROG);
+		EnterMovementState(ESymplMovementState::ZeroG);
 	}
 	else
 	{
-		RestoreLastMovementMode();
+		ExitMovementState(ESymplMovementState::ZeroG);
 	}
 	DidZeroG.Broadcast(this);
 }
@@ -1290,14 +3061,19 @@ bool USymplAdvancedMovementComponent::Server_SetZeroGMovement_Validate(bool bZer
 
 void USymplAdvancedMovementComponent::Server_SetJetpack_Implementation(bool bPressed)
 {
-	bJetpackActive = bPressed;
-	if (bJetpackActive)
+	SYMPL_SCOPE(Server_SetJetpack);
+	if (!AcceptServerRpc(ESymplMovementRpc::ESETJETPACK))
 	{
-		Server_SetMovementMode(EAdvancedMovementMode::EJETPACK);
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
+	if (bPressed)
+	{
+		EnterMovementState(ESymplMovementState::Jetpack);
 	}
 	else
 	{
-		RestoreLastMovementMode();
+		ExitMovementState(ESymplMovementState::Jetpack);
 	}
 	DidJetpack.Broadcast(this);
 }
@@ -1306,31 +3082,117 @@ bool USymplAdvancedMovementComponent::Server_SetJetpack_Validate(bool bPressed)
 
 void USymplAdvancedMovementComponent::Server_SetJetpackFuel_Implementation(double Value)
 {
-	CurrentJetpackFuel = Value;
+	SYMPL_SCOPE(Server_SetJetpackFuel);
+	if (!AcceptServerRpc(ESymplMovementRpc::ESETJETPACKFUEL))
+	{
+		return;
+	}
+	const double time = GetServerWorldTime();
+	//Clients can only move the fuel by a fraction of a second of draining or refueling.
+	if (IsClientServerRpc())
+	{
+		const double tolerance = FMath::Max(GetTuning().JetpackDrainPerSecond, GetTuning().JetpackRefuelPerSecond) * GetDefault<USymplAdvancedMovementSettings>()->JetpackFuelStepTolerance;
+		if (FMath::Abs(Value - RuntimeState.JetpackFuel.GetValue(time)) > tolerance)
+		{
+			RejectServerRpc(ESymplMovementRpc::ESETJETPACKFUEL);
+			return;
+		}
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
+	RuntimeState.JetpackFuel.SetMaxValue(time, GetTuning().MaxJetpackFuel);
+	RuntimeState.JetpackFuel.SetValue(time, Value);
 	JetpackFuelUpdate.Broadcast(this);
 }
 
-bool USymplAdvancedMovementComponent::Server_SetJetpackFuel_Validate(double Value) { return true; }
+bool USymplAdvancedMovementComponent::Server_SetJetpackFuel_Validate(double Value) { return FMath::IsFinite(Value); }
 
 void USymplAdvancedMovementComponent::Server_UpdateTransform_Implementation(FTransform Transform)
 {
+	SYMPL_SCOPE(Server_UpdateTransform);
+	if (!AcceptServerRpc(ESymplMovementRpc::EUPDATETRANSFORM))
+	{
+		return;
+	}
+	//Don't let clients teleport.
+	const double maxDelta = GetDefault<USymplAdvancedMovementSettings>()->MaxClientTransformDelta;
+	if (IsClientServerRpc() && maxDelta > 0.f && FVector::Dist(Transform.GetLocation(), OwnerRef->GetActorLocation()) > maxDelta)
+	{
+		RejectServerRpc(ESymplMovementRpc::EUPDATETRANSFORM);
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
 	OwnerRef->SetActorTransform(Transform);
 }
 
-bool USymplAdvancedMovementComponent::Server_UpdateTransform_Validate(FTransform Transform) { return true; }
+bool USymplAdvancedMovementComponent::Server_UpdateTransform_Validate(FTransform Transform) { return Transform.IsValid(); }
 
 void USymplAdvancedMovementComponent::MoveToLastGroundLocation()
 {
-	Server_UpdateTransform(FTransform(OwnerRef->GetActorRotation(), LastGroundLocation, OwnerRef->GetActorScale3D()));
+	Server_RewindTrajectory(0.f, true);
 }
 
 void USymplAdvancedMovementComponent::MoveToLastAirLocation()
 {
-	Server_UpdateTransform(FTransform(OwnerRef->GetActorRotation(), LastAirLocation, OwnerRef->GetActorScale3D()));
+	Server_RewindTrajectory(0.f, false);
+}
+
+void USymplAdvancedMovementComponent::Server_RewindTrajectory_Implementation(double SecondsAgo, bool bGrounded)
+{
+	SYMPL_SCOPE(Server_RewindTrajectory);
+	if (!AcceptServerRpc(ESymplMovementRpc::EREWINDTRAJECTORY))
+	{
+		return;
+	}
+	TGuardValue<int32> internalCall(InternalCallDepth, InternalCallDepth + 1);
+	//Find the newest matching sample that is old enough.
+	FSymplTrajectorySample sample;
+	if (!OwnerRef || !TrajectoryHistory.FindNewest(bGrounded, GetServerWorldTime() - SecondsAgo, sample))
+	{
+		return;
+	}
+	OwnerRef->SetActorLocation(sample.Location, false, nullptr, ETeleportType::TeleportPhysics);
+	if (OwnerAsPawn && OwnerAsPawn->GetMovementComponent())
+	{
+		OwnerAsPawn->GetMovementComponent()->StopMovementImmediately();
+	}
+}
+
+bool USymplAdvancedMovementComponent::Server_RewindTrajectory_Validate(double SecondsAgo, bool bGrounded) { return FMath::IsFinite(SecondsAgo) && SecondsAgo >= 0.f; }
+
+void USymplAdvancedMovementComponent::GetTrajectory(TArray<FSymplTrajectorySample>& OutSamples) const
+{
+	TrajectoryHistory.CopyTo(OutSamples);
+}
+
+bool USymplAdvancedMovementComponent::GetTrajectorySampleAtTime(double Time, FSymplTrajectorySample& OutSample) const
+{
+	return TrajectoryHistory.SampleAtTime(Time, OutSample);
+}
+
+FVector USymplAdvancedMovementComponent::GetLastGroundLocation() const
+{
+	return LastGroundLocation;
+}
+
+FVector USymplAdvancedMovementComponent::GetLastAirLocation() const
+{
+	return LastAirLocation;
+}
+
+double USymplAdvancedMovementComponent::GetServerWorldTime() const
+{
+	const UWorld* world = GetWorld();
+	if (!world)
+	{
+		return 0.f;
+	}
+	const AGameStateBase* gameState = world->GetGameState();
+	return gameState ? gameState->GetServerWorldTimeSeconds() : world->GetTimeSeconds();
 }
 
 void USymplAdvancedMovementComponent::Client_Crouch_Implementation(bool bPressed)
 {
+	SYMPL_SCOPE(Client_Crouch);
 	if (OwnerAsChar)
 	{
 		if (bPressed)
@@ -1344,8 +3206,27 @@ void USymplAdvancedMovementComponent::Client_Crouch_Implementation(bool bPressed
 	}
 }
 
+void USymplAdvancedMovementComponent::Client_CorrectMovement_Implementation(FVector Location, FVector Velocity, EAdvancedMovementMode Mode)
+{
+	SYMPL_SCOPE(Client_CorrectMovement);
+	if (!OwnerRef)
+	{
+		return;
+	}
+	OwnerRef->SetActorLocation(Location, false, nullptr, ETeleportType::TeleportPhysics);
+	if (OwnerAsPawn && OwnerAsPawn->GetMovementComponent())
+	{
+		OwnerAsPawn->GetMovementComponent()->Velocity = Velocity;
+	}
+	RuntimeState.CurrentMovementMode = Mode;
+	bHasPendingMovementMode = false;
+	bHasPendingLastMovementMode = false;
+	RuntimeState.CurrentMovementType = EMovementAnimType::ENONE;
+}
+
 void USymplAdvancedMovementComponent::Client_Jump_Implementation(bool bPressed)
 {
+	SYMPL_SCOPE(Client_Jump);
 	if (OwnerAsChar)
 	{
 		if (bPressed)
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SymplAdvancedMovementSettings.h"
+
+USymplAdvancedMovementSettings::USymplAdvancedMovementSettings()
+{
+	// Set defaults.
+	bEnableTickLOD = true;
+	AuthorityTickInterval = 0.f;
+	AutonomousProxyTickInterval = 0.f;
+	SimulatedProxyTickInterval = .033f;
+	bSimulatedProxyCosmeticOnly = true;
+	NearDistance = 2500.f;
+	FarDistance = 10000.f;
+	FarTickInterval = .25f;
+	OffscreenTickInterval = .5f;
+	TickLODUpdateInterval = .5f;
+	ServerSimulationRate = 0.f;
+	bInterpolateSimulatedProxies = true;
+	bEnableRpcRateLimiting = true;
+	DefaultRpcRateLimit = FSymplRpcRateLimit(30.f, 10.f);
+	//The client sends these every frame while the matching input is held.
+	RpcRateLimits.Add(ESymplMovementRpc::ESETINPUT, FSymplRpcRateLimit(400.f, 60.f));
+	RpcRateLimits.Add(ESymplMovementRpc::ECLIMBCHECK, FSymplRpcRateLimit(400.f, 60.f));
+	RpcRateLimits.Add(ESymplMovementRpc::EDOCLIMB, FSymplRpcRateLimit(200.f, 30.f));
+	RpcRateLimits.Add(ESymplMovementRpc::ESETJETPACKFUEL, FSymplRpcRateLimit(150.f, 30.f));
+	RpcRateLimits.Add(ESymplMovementRpc::ESETMOVEMENTMODE, FSymplRpcRateLimit(60.f, 20.f));
+	//Abilities get a press and a release per use.
+	RpcRateLimits.Add(ESymplMovementRpc::EDASH, FSymplRpcRateLimit(6.f, 4.f));
+	RpcRateLimits.Add(ESymplMovementRpc::EBLINK, FSymplRpcRateLimit(6.f, 4.f));
+	RpcRateLimits.Add(ESymplMovementRpc::EROLL, FSymplRpcRateLimit(6.f, 4.f));
+	//These should only happen once in a while.
+	RpcRateLimits.Add(ESymplMovementRpc::EINITIALIZE, FSymplRpcRateLimit(.2f, 2.f));
+	RpcRateLimits.Add(ESymplMovementRpc::ESETMOVEMENTSPEEDS, FSymplRpcRateLimit(1.f, 3.f));
+	RpcRateLimits.Add(ESymplMovementRpc::EUPDATETRANSFORM, FSymplRpcRateLimit(2.f, 2.f));
+	RpcRateLimits.Add(ESymplMovementRpc::EREWINDTRAJECTORY, FSymplRpcRateLimit(1.f, 2.f));
+	MaxClientTransformDelta = 500.f;
+	JetpackFuelStepTolerance = .25f;
+	MaxClientMovementSpeed = 10000.f;
+	bEnableRewindValidation = true;
+	MaxRewindTime = .5f;
+	RewindTolerance = 25.f;
+	BlinkProbeDistance = 50.f;
+}
+
+const FSymplRpcRateLimit& USymplAdvancedMovementSettings::GetRpcRateLimit(ESymplMovementRpc Rpc) const
+{
+	const FSymplRpcRateLimit* limit = RpcRateLimits.Find(Rpc);
+	return limit ? *limit : DefaultRpcRateLimit;
+}
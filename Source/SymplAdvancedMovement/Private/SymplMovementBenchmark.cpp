@@ -0,0 +1,699 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SymplMovementBenchmark.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/Character.h"
+#include "AIController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include "SymplAdvancedMovementComponent.h"
+#include "SymplMovementCounters.h"
+#include "SymplMovementRollback.h"
+#include "SymplMovementSimulation.h"
+
+namespace SymplMovementBenchmark
+{
+	//Distance between pawns in a row.
+	constexpr double PawnSpacing = 200.f;
+
+	//Distance between rows, leaves room for the walls.
+	constexpr double RowSpacing = 600.f;
+
+	//How often scripted abilities are pressed, in frames.
+	constexpr int32 AbilityInterval = 60;
+
+	//The last counters we measured against.
+	static FSymplMovementCounters LastCounters;
+
+	static TSharedPtr<FSymplMovementBenchmark> Running;
+
+	//Fixed answers so the sim core runs without a world.
+	class FStubQueries : public ISymplMovementSimQueries
+	{
+
+	public:
+
+		virtual double QuerySlopeAngle() const override { return 10.f; }
+		virtual double QuerySlopeSpeedScalar(double SlopeAngle) const override { return 1.f - SlopeAngle / 180.f; }
+		virtual bool QueryModeSpeed(EAdvancedMovementMode Mode, double& OutSpeed) const override
+		{
+			OutSpeed = Mode == EAdvancedMovementMode::ESPRINT ? 1000.f : 600.f;
+			return true;
+		}
+
+	};
+
+	//The copy the component makes from its runtime state into the simulation every step, see GatherSimState.
+	static FSymplMovementSimState GatherSimState(const FSymplMovementRuntimeState& Runtime)
+	{
+		FSymplMovementSimState state;
+		state.Flags = (ESymplMovementSimFlags)Runtime.MovementStateFlags;
+		state.MovementMode = Runtime.CurrentMovementMode;
+		state.LastMovementMode = Runtime.LastMovementMode;
+		state.MovementType = Runtime.CurrentMovementType;
+		state.DoubleJumpCounter = Runtime.DoubleJumpCounter;
+		state.Velocity = Runtime.CurrentVelocity;
+		state.DashDirection = Runtime.CurrentDashDirection;
+		state.BlinkDirection = Runtime.CurrentBlinkDirection;
+		state.RollDirection = Runtime.CurrentRollDirection;
+		state.DashStartTime = Runtime.DashStartTime;
+		state.BlinkStartTime = Runtime.BlinkStartTime;
+		state.RollStartTime = Runtime.RollStartTime;
+		state.HoverStartTime = Runtime.HoverStartTime;
+		state.SlideStartTime = Runtime.SlideStartTime;
+		state.ClimbStartTime = Runtime.ClimbStartTime;
+		state.JetpackFuel = Runtime.JetpackFuel;
+		state.SprintStamina = Runtime.SprintStamina;
+		state.SlopeAngle = Runtime.CurrentSlopeAngle;
+		state.SlopeSpeedScalar = Runtime.CurrentSlopeSpeedScalar;
+		state.Speed = Runtime.CurrentSpeed;
+		return state;
+	}
+
+	//The copy back, see ApplySimResult.
+	static void WriteSimState(const FSymplMovementSimResult& Result, FSymplMovementRuntimeState& Runtime)
+	{
+		Runtime.CurrentSlopeAngle = Result.State.SlopeAngle;
+		Runtime.CurrentSlopeSpeedScalar = Result.State.SlopeSpeedScalar;
+		Runtime.CurrentSpeed = Result.State.Speed;
+		Runtime.CurrentMovementType = Result.State.MovementType;
+		Runtime.JetpackFuel = Result.State.JetpackFuel;
+		Runtime.SprintStamina = Result.State.SprintStamina;
+		if (Result.Has(ESymplMovementSimEvents::Jetpacking))
+		{
+			Runtime.CurrentVelocity = Result.JetpackVelocity;
+		}
+	}
+
+	static AStaticMeshActor* SpawnBox(UWorld* World, UStaticMesh* Mesh, const FVector& Location, const FVector& Scale)
+	{
+		AStaticMeshActor* box = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator);
+		if (box)
+		{
+			box->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+			box->GetStaticMeshComponent()->SetStaticMesh(Mesh);
+			box->SetActorScale3D(Scale);
+		}
+		return box;
+	}
+}
+
+FSymplMovementBenchmark::FSymplMovementBenchmark(UWorld* InWorld, const TArray<int32>& InCounts, const TArray<EScenario>& InScenarios, int32 InFrames, bool bInQuitWhenDone)
+	: World(InWorld)
+	, Counts(InCounts)
+	, Scenarios(InScenarios)
+	, Frames(FMath::Max(InFrames, 1))
+	, WarmUpFrames(30)
+	, bQuitWhenDone(bInQuitWhenDone)
+	, RunIndex(0)
+	, Frame(0)
+	, bMeasuring(false)
+{
+}
+
+FSymplMovementBenchmark::~FSymplMovementBenchmark()
+{
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	}
+}
+
+const TCHAR* FSymplMovementBenchmark::GetScenarioName(EScenario Scenario)
+{
+	switch (Scenario)
+	{
+	case EScenario::Idle: return TEXT("Idle");
+	case EScenario::Walk: return TEXT("Walk");
+	case EScenario::Sprint: return TEXT("Sprint");
+	case EScenario::WallJump: return TEXT("WallJump");
+	case EScenario::Dash: return TEXT("Dash");
+	case EScenario::Jetpack: return TEXT("Jetpack");
+	case EScenario::Parachute: return TEXT("Parachute");
+	default: return TEXT("None");
+	}
+}
+
+void FSymplMovementBenchmark::Start()
+{
+	UE_LOG(LogTemp, Display, TEXT("SymplMovementBenchmark: %d scenarios x %d counts, %d frames each."), Scenarios.Num(), Counts.Num(), Frames);
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FSymplMovementBenchmark::Tick));
+	SpawnRun();
+}
+
+bool FSymplMovementBenchmark::Tick(float DeltaTime)
+{
+	if (!World.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SymplMovementBenchmark: World went away, stopping."));
+		Finish();
+		return false;
+	}
+	//The components ticked once since our last call, so the counter delta is one frame.
+	if (bMeasuring)
+	{
+		MeasureFrame();
+	}
+	Frame++;
+	if (!bMeasuring && Frame >= WarmUpFrames)
+	{
+		bMeasuring = true;
+		Frame = 0;
+	}
+	else if (bMeasuring && Frame >= Frames)
+	{
+		FinishRun();
+		if (RunIndex >= Counts.Num() * Scenarios.Num())
+		{
+			Finish();
+			return false;
+		}
+		SpawnRun();
+	}
+	DriveRun();
+	SymplMovementBenchmark::LastCounters = FSymplMovementCounters::Get();
+	return true;
+}
+
+void FSymplMovementBenchmark::SpawnRun()
+{
+	UWorld* world = World.Get();
+	const EScenario scenario = Scenarios[RunIndex / Counts.Num()];
+	const int32 count = Counts[RunIndex % Counts.Num()];
+	const int32 perRow = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt((double)count)));
+	const int32 rows = FMath::DivideAndRoundUp(count, perRow);
+
+	Current = FResult();
+	Current.Scenario = GetScenarioName(scenario);
+	Current.Count = count;
+	Frame = 0;
+	bMeasuring = false;
+
+	UStaticMesh* cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	const bool bInAir = scenario == EScenario::Parachute;
+	const double height = bInAir ? 20000.f : 100.f;
+
+	if (cube && !bInAir)
+	{
+		//The basic cube is 100 units across.
+		const FVector extent(rows * RowSpacing, perRow * PawnSpacing, 0.f);
+		Props.Add(SymplMovementBenchmark::SpawnBox(world, cube, extent * .5f - FVector(0.f, 0.f, 50.f), FVector(extent.X / 100.f + 2.f, extent.Y / 100.f + 2.f, 1.f)));
+		if (scenario == EScenario::WallJump)
+		{
+			for (int32 row = 0; row < rows; row++)
+			{
+				Props.Add(SymplMovementBenchmark::SpawnBox(world, cube, FVector(row * RowSpacing + 250.f, extent.Y * .5f, 500.f), FVector(.2f, extent.Y / 100.f, 10.f)));
+			}
+		}
+	}
+
+	TArray<FSymplMovementSpeeds> speeds;
+	speeds.Add(FSymplMovementSpeeds("Walk", EAdvancedMovementMode::EWALK, 600.f));
+	speeds.Add(FSymplMovementSpeeds("Sprint", EAdvancedMovementMode::ESPRINT, 1000.f));
+	speeds.Add(FSymplMovementSpeeds("Crouch", EAdvancedMovementMode::ECROUCH, 300.f));
+	speeds.Add(FSymplMovementSpeeds("Prone", EAdvancedMovementMode::EPRONE, 150.f));
+	speeds.Add(FSymplMovementSpeeds("Fly", EAdvancedMovementMode::EFLY, 600.f));
+
+	const USymplAdvancedMovementComponent* defaults = GetDefault<USymplAdvancedMovementComponent>();
+	FActorSpawnParameters params;
+	params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	int64 bytes = 0;
+	for (int32 i = 0; i < count; i++)
+	{
+		const FVector location((i / perRow) * RowSpacing, (i % perRow) * PawnSpacing + PawnSpacing * .5f, height);
+		ACharacter* pawn = world->SpawnActor<ACharacter>(ACharacter::StaticClass(), location, FRotator::ZeroRotator, params);
+		if (!pawn)
+		{
+			continue;
+		}
+		//An ai controller makes the character consume movement input.
+		pawn->AIControllerClass = AAIController::StaticClass();
+		pawn->SpawnDefaultController();
+
+		//The component needs its wall checkers before it initializes.
+		const TPair<FName, FVector> checkers[] = {
+			TPair<FName, FVector>(defaults->FrontWallCheckTag, FVector(100.f, 0.f, 0.f)),
+			TPair<FName, FVector>(defaults->RightWallCheckTag, FVector(0.f, 100.f, 0.f)),
+			TPair<FName, FVector>(defaults->LeftWallCheckTag, FVector(0.f, -100.f, 0.f)) };
+		for (const TPair<FName, FVector>& checker : checkers)
+		{
+			USceneComponent* scene = NewObject<USceneComponent>(pawn);
+			scene->ComponentTags.Add(checker.Key);
+			scene->SetupAttachment(pawn->GetRootComponent());
+			scene->SetRelativeLocation(checker.Value);
+			scene->RegisterComponent();
+		}
+
+		USymplAdvancedMovementComponent* movement = NewObject<USymplAdvancedMovementComponent>(pawn);
+		movement->bAutoInit = true;
+		pawn->AddInstanceComponent(movement);
+		movement->RegisterComponent();
+		movement->Server_SetMovementSpeeds(speeds, EAdvancedMovementMode::EWALK, true);
+
+		switch (scenario)
+		{
+		case EScenario::Sprint:
+			movement->Server_Sprint(true);
+			break;
+		case EScenario::Jetpack:
+			movement->Server_SetJetpack(true);
+			break;
+		case EScenario::Parachute:
+			movement->Server_DeployParachute();
+			break;
+		default:
+			break;
+		}
+
+		bytes += movement->GetClass()->GetStructureSize() + movement->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		Pawns.Add(pawn);
+	}
+	Current.BytesPerComponent = Pawns.Num() > 0 ? bytes / Pawns.Num() : 0;
+	UE_LOG(LogTemp, Display, TEXT("SymplMovementBenchmark: %s x %d"), *Current.Scenario, Pawns.Num());
+}
+
+void FSymplMovementBenchmark::DespawnRun()
+{
+	for (const TWeakObjectPtr<ACharacter>& pawn : Pawns)
+	{
+		if (pawn.IsValid())
+		{
+			if (AController* controller = pawn->GetController())
+			{
+				controller->Destroy();
+			}
+			pawn->Destroy();
+		}
+	}
+	for (const TWeakObjectPtr<AActor>& prop : Props)
+	{
+		if (prop.IsValid())
+		{
+			prop->Destroy();
+		}
+	}
+	Pawns.Reset();
+	Props.Reset();
+}
+
+void FSymplMovementBenchmark::DriveRun()
+{
+	const EScenario scenario = Scenarios[RunIndex / Counts.Num()];
+	for (int32 i = 0; i < Pawns.Num(); i++)
+	{
+		ACharacter* pawn = Pawns[i].Get();
+		if (!pawn)
+		{
+			continue;
+		}
+		USymplAdvancedMovementComponent* movement = pawn->FindComponentByClass<USymplAdvancedMovementComponent>();
+		//Stagger presses so every pawn doesn't fire on the same frame.
+		const int32 phase = (Frame + i) % AbilityInterval;
+		switch (scenario)
+		{
+		case EScenario::Walk:
+		case EScenario::Sprint:
+			pawn->AddMovementInput(pawn->GetActorForwardVector(), 1.f);
+			break;
+		case EScenario::WallJump:
+			pawn->AddMovementInput(pawn->GetActorForwardVector(), 1.f);
+			if (phase == 0 || phase == 1)
+			{
+				movement->Server_AdvancedJump(phase == 0);
+			}
+			break;
+		case EScenario::Dash:
+			pawn->AddMovementInput(pawn->GetActorForwardVector(), 1.f);
+			if (phase == 0)
+			{
+				movement->Server_Dash(true, pawn->GetActorForwardVector(), false);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+void FSymplMovementBenchmark::MeasureFrame()
+{
+	const FSymplMovementCounters& now = FSymplMovementCounters::Get();
+	const FSymplMovementCounters& last = SymplMovementBenchmark::LastCounters;
+	const double frameMs = FPlatformTime::ToMilliseconds64(now.TickCycles - last.TickCycles);
+	const int64 ticks = now.Ticks - last.Ticks;
+	Current.Frames++;
+	Current.AvgFrameMs += frameMs;
+	Current.MaxFrameMs = FMath::Max(Current.MaxFrameMs, frameMs);
+	Current.AvgTickUs += ticks > 0 ? frameMs * 1000.f / ticks : 0.f;
+	Current.TracesPerFrame += now.Traces - last.Traces;
+	Current.RpcsPerFrame += (now.ServerRpcs - last.ServerRpcs) + (now.MulticastRpcs - last.MulticastRpcs);
+}
+
+void FSymplMovementBenchmark::FinishRun()
+{
+	DespawnRun();
+	if (Current.Frames > 0)
+	{
+		Current.AvgFrameMs /= Current.Frames;
+		Current.AvgTickUs /= Current.Frames;
+		Current.TracesPerFrame /= Current.Frames;
+		Current.RpcsPerFrame /= Current.Frames;
+	}
+	UE_LOG(LogTemp, Display, TEXT("SymplMovementBenchmark: %s x %d: %.3f ms/frame (max %.3f), %.2f us/tick, %.1f traces/frame, %.1f rpcs/frame, %lld bytes/component"),
+		*Current.Scenario, Current.Count, Current.AvgFrameMs, Current.MaxFrameMs, Current.AvgTickUs, Current.TracesPerFrame, Current.RpcsPerFrame, Current.BytesPerComponent);
+	Results.Add(Current);
+	RunIndex++;
+}
+
+void FSymplMovementBenchmark::Finish()
+{
+	DespawnRun();
+	Results.Add(RunSimulation(FMath::Max(Counts.Num() > 0 ? Counts.Last() : 1000, 1), Frames));
+	const FString path = WriteResults(Results);
+	UE_LOG(LogTemp, Display, TEXT("SymplMovementBenchmark: Wrote %s"), *path);
+	TickHandle.Reset();
+	if (bQuitWhenDone)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+	//Last thing we do, this may delete us.
+	SymplMovementBenchmark::Running.Reset();
+}
+
+FSymplMovementBenchmark::FResult FSymplMovementBenchmark::RunSimulation(int32 Count, int32 Steps)
+{
+	FSymplMovementSimConfig config;
+	SymplMovementBenchmark::FStubQueries queries;
+	TArray<FSymplMovementSimState> states;
+	TArray<FSymplMovementSimInput> inputs;
+	states.SetNum(Count);
+	inputs.SetNum(Count);
+	//Spread the simulations over the abilities so every branch of Step runs.
+	for (int32 i = 0; i < Count; i++)
+	{
+		FSymplMovementSimState& state = states[i];
+		state.MovementMode = (i & 1) ? EAdvancedMovementMode::ESPRINT : EAdvancedMovementMode::EWALK;
+		state.JetpackFuel = FSymplResourceMeter(config.MaxJetpackFuel, config.MaxJetpackFuel);
+		state.DashDirection = state.BlinkDirection = state.RollDirection = FVector::ForwardVector;
+		state.Set(ESymplMovementSimFlags::Dashing, i % 7 == 1);
+		state.Set(ESymplMovementSimFlags::Blinking, i % 7 == 2);
+		state.Set(ESymplMovementSimFlags::Rolling, i % 7 == 3);
+		state.Set(ESymplMovementSimFlags::Hovering, i % 7 == 4);
+		state.Set(ESymplMovementSimFlags::Sliding, i % 7 == 5);
+		state.Set(ESymplMovementSimFlags::JetpackActive, i % 7 == 6);
+		state.DashStartTime = state.BlinkStartTime = state.RollStartTime = state.HoverStartTime = state.SlideStartTime = 0.f;
+		inputs[i].MoveInput = FVector(1.f, 0.f, 0.f);
+		inputs[i].Velocity = FVector(900.f, 0.f, 0.f);
+		inputs[i].bIsCharacter = true;
+		inputs[i].bHasAuthority = true;
+	}
+
+	FResult result;
+	result.Scenario = TEXT("SimCore");
+	result.Count = Count;
+	result.BytesPerComponent = sizeof(FSymplMovementSimState);
+	double checksum = 0.f;
+	const double deltaTime = 1.f / 60.f;
+	for (int32 step = 0; step < Steps; step++)
+	{
+		const double start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Count; i++)
+		{
+			inputs[i].Time = step * deltaTime;
+			const FSymplMovementSimResult stepped = SymplMovementSimulation::Step(config, states[i], inputs[i], deltaTime, queries);
+			states[i] = stepped.State;
+			checksum += stepped.DashLaunch.X + stepped.State.JetpackFuel.GetValue(inputs[i].Time);
+		}
+		const double frameMs = (FPlatformTime::Seconds() - start) * 1000.f;
+		result.Frames++;
+		result.AvgFrameMs += frameMs;
+		result.MaxFrameMs = FMath::Max(result.MaxFrameMs, frameMs);
+	}
+	if (result.Frames > 0)
+	{
+		result.AvgFrameMs /= result.Frames;
+		result.AvgTickUs = Count > 0 ? result.AvgFrameMs * 1000.f / Count : 0.f;
+	}
+	UE_LOG(LogTemp, Display, TEXT("SymplMovementBenchmark: SimCore x %d: %.3f ms/step (max %.3f), %.3f us/sim (checksum %f)"),
+		Count, result.AvgFrameMs, result.MaxFrameMs, result.AvgTickUs, checksum);
+	return result;
+}
+
+FSymplMovementBenchmark::FResult FSymplMovementBenchmark::RunRollback(int32 Count, int32 Steps, int32 RollbackFrames)
+{
+	FSymplMovementSimConfig config;
+	SymplMovementBenchmark::FStubQueries queries;
+	//What a component and its owner hold, so the rollback frames copy the same amount as StepFixedTick and Rewind.
+	TArray<FSymplMovementSnapshotState> components;
+	TArray<FTransform> transforms;
+	TArray<FSymplMovementRollbackBuffer> buffers;
+	components.SetNum(Count);
+	transforms.SetNum(Count);
+	buffers.SetNum(Count);
+	for (int32 i = 0; i < Count; i++)
+	{
+		FSymplMovementSnapshotState& component = components[i];
+		component.RuntimeState.CurrentMovementMode = EAdvancedMovementMode::EWALK;
+		component.RuntimeState.JetpackFuel = FSymplResourceMeter(config.MaxJetpackFuel, config.MaxJetpackFuel);
+		component.RuntimeState.CurrentDashDirection = FVector::ForwardVector;
+		component.ModeStack.Reset(EAdvancedMovementMode::EWALK);
+		component.ModeStack.Push(ESymplMovementState::Sprinting, EAdvancedMovementMode::ESPRINT);
+		component.DashCharges = FSymplResourceMeter(1.f, 1.f);
+		component.BlinkCharges = FSymplResourceMeter(1.f, 1.f);
+		component.RollCharges = FSymplResourceMeter(1.f, 1.f);
+		transforms[i].SetTranslation(FVector(i * SymplMovementBenchmark::PawnSpacing, 0.f, 0.f));
+		buffers[i].Init(RollbackFrames + 1);
+	}
+
+	FResult result;
+	result.Scenario = TEXT("Rollback");
+	result.Count = Count;
+	result.BytesPerComponent = Count > 0 ? buffers[0].GetAllocatedSize() : 0;
+	double checksum = 0.f;
+	const double deltaTime = 1.f / 60.f;
+	const uint32 dashFlag = (uint32)ESymplMovementSimFlags::Dashing;
+	for (int32 step = 0; step < Steps; step++)
+	{
+		const double start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Count; i++)
+		{
+			FSymplMovementSnapshotState& component = components[i];
+			FSymplMovementRuntimeState& runtime = component.RuntimeState;
+
+			//Advance one tick, with a dash every so often so the state keeps changing.
+			FSymplMovementSimInput input;
+			input.MoveInput = FVector(1.f, 0.f, 0.f);
+			input.Velocity = runtime.CurrentVelocity;
+			input.Rotation = transforms[i].GetRotation();
+			input.bIsCharacter = true;
+			input.bHasAuthority = true;
+			input.Time = step * deltaTime;
+			const bool bDashing = (step + i) % SymplMovementBenchmark::AbilityInterval < 10;
+			runtime.MovementStateFlags = bDashing ? runtime.MovementStateFlags | dashFlag : runtime.MovementStateFlags & ~dashFlag;
+			if (bDashing && runtime.DashStartTime < 0.f)
+			{
+				runtime.DashStartTime = input.Time;
+			}
+
+			//StepFixedTick.
+			FSymplMovementRollbackFrame& frame = buffers[i].Add(step);
+			frame.State = component;
+			frame.Transform = transforms[i];
+			frame.Velocity = runtime.CurrentVelocity;
+			frame.Input = input;
+			SymplMovementBenchmark::WriteSimState(SymplMovementSimulation::Step(config, SymplMovementBenchmark::GatherSimState(runtime), input, deltaTime, queries), runtime);
+			transforms[i].AddToTranslation(input.Rotation.GetForwardVector() * runtime.CurrentSpeed * deltaTime);
+
+			//A late input arrived for the oldest frame we keep: Rollback rewinds and resimulates up to now.
+			const int32 rewindFrame = step + 1 - RollbackFrames;
+			if (const FSymplMovementRollbackFrame* rewind = buffers[i].Find(rewindFrame))
+			{
+				//Rewind, then put the owner back where it was.
+				const FTransform transform = transforms[i];
+				const FVector velocity = runtime.CurrentVelocity;
+				component = rewind->State;
+				transforms[i] = rewind->Transform;
+				transforms[i] = transform;
+				runtime.CurrentVelocity = velocity;
+
+				//Resimulate.
+
+				FSymplMovementSimState state = SymplMovementBenchmark::GatherSimState(runtime);
+				FSymplMovementSimResult resim;
+				for (int32 frameIndex = rewindFrame; frameIndex <= step; frameIndex++)
+				{
+					FSymplMovementRollbackFrame* stored = buffers[i].Find(frameIndex);
+					if (frameIndex != rewindFrame)
+					{
+						SymplMovementBenchmark::WriteSimState(resim, stored->State.RuntimeState);
+					}
+					resim = SymplMovementSimulation::Step(config, state, stored->Input, deltaTime, queries);
+					state = resim.State;
+				}
+				SymplMovementBenchmark::WriteSimState(resim, runtime);
+			}
+			checksum += runtime.CurrentSpeed;
+		}
+		const double frameMs = (FPlatformTime::Seconds() - start) * 1000.f;
+		result.Frames++;
+		result.AvgFrameMs += frameMs;
+		result.MaxFrameMs = FMath::Max(result.MaxFrameMs, frameMs);
+	}
+	if (result.Frames > 0)
+	{
+		result.AvgFrameMs /= result.Frames;
+		result.AvgTickUs = Count > 0 ? result.AvgFrameMs * 1000.f / Count : 0.f;
+	}
+	UE_LOG(LogTemp, Display, TEXT("SymplMovementBenchmark: Rollback of %d frames x %d: %.3f ms/tick (max %.3f), %.3f us/sim (checksum %f)"),
+		RollbackFrames, Count, result.AvgFrameMs, result.MaxFrameMs, result.AvgTickUs, checksum);
+	return result;
+}
+
+FString FSymplMovementBenchmark::WriteResults(const TArray<FResult>& Results)
+{
+	const FString base = FPaths::ProfilingDir() / TEXT("SymplMovement") / FString::Printf(TEXT("Benchmark-%s"), *FDateTime::Now().ToString());
+
+	FString csv = TEXT("Scenario,Count,Frames,AvgFrameMs,MaxFrameMs,AvgTickUs,TracesPerFrame,RpcsPerFrame,BytesPerComponent\n");
+	FString json = TEXT("[\n");
+	for (int32 i = 0; i < Results.Num(); i++)
+	{
+		const FResult& result = Results[i];
+		csv += FString::Printf(TEXT("%s,%d,%d,%.4f,%.4f,%.4f,%.2f,%.2f,%lld\n"),
+			*result.Scenario, result.Count, result.Frames, result.AvgFrameMs, result.MaxFrameMs, result.AvgTickUs, result.TracesPerFrame, result.RpcsPerFrame, result.BytesPerComponent);
+		json += FString::Printf(TEXT("\t{\"scenario\": \"%s\", \"count\": %d, \"frames\": %d, \"avgFrameMs\": %.4f, \"maxFrameMs\": %.4f, \"avgTickUs\": %.4f, \"tracesPerFrame\": %.2f, \"rpcsPerFrame\": %.2f, \"bytesPerComponent\": %lld}%s\n"),
+			*result.Scenario, result.Count, result.Frames, result.AvgFrameMs, result.MaxFrameMs, result.AvgTickUs, result.TracesPerFrame, result.RpcsPerFrame, result.BytesPerComponent,
+			i + 1 < Results.Num() ? TEXT(",") : TEXT(""));
+	}
+	json += TEXT("]\n");
+
+	FFileHelper::SaveStringToFile(csv, *(base + TEXT(".csv")));
+	FFileHelper::SaveStringToFile(json, *(base + TEXT(".json")));
+	return base + TEXT(".csv");
+}
+
+static void SymplBenchmarkCommand(const TArray<FString>& Args, UWorld* World)
+{
+	if (SymplMovementBenchmark::Running.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SymplMovementBenchmark: Already running."));
+		return;
+	}
+	if (!World)
+	{
+		return;
+	}
+	TArray<int32> counts = { 10, 100, 1000, 5000 };
+	TArray<FSymplMovementBenchmark::EScenario> scenarios;
+	for (uint8 i = 0; i < (uint8)FSymplMovementBenchmark::EScenario::Max; i++)
+	{
+		scenarios.Add((FSymplMovementBenchmark::EScenario)i);
+	}
+	int32 frames = 300;
+	bool bQuit = false;
+
+	//Counts=10,100 Scenarios=Walk,Dash Frames=300 Quit
+	for (const FString& arg : Args)
+	{
+		FString key, value;
+		if (!arg.Split(TEXT("="), &key, &value))
+		{
+			bQuit |= arg.Equals(TEXT("Quit"), ESearchCase::IgnoreCase);
+			continue;
+		}
+		TArray<FString> values;
+		value.ParseIntoArray(values, TEXT(","));
+		if (key.Equals(TEXT("Counts"), ESearchCase::IgnoreCase))
+		{
+			counts.Reset();
+			for (const FString& count : values)
+			{
+				counts.Add(FMath::Max(FCString::Atoi(*count), 1));
+			}
+		}
+		else if (key.Equals(TEXT("Scenarios"), ESearchCase::IgnoreCase))
+		{
+			scenarios.Reset();
+			for (const FString& name : values)
+			{
+				for (uint8 i = 0; i < (uint8)FSymplMovementBenchmark::EScenario::Max; i++)
+				{
+					if (name.Equals(FSymplMovementBenchmark::GetScenarioName((FSymplMovementBenchmark::EScenario)i), ESearchCase::IgnoreCase))
+					{
+						scenarios.Add((FSymplMovementBenchmark::EScenario)i);
+					}
+				}
+			}
+		}
+		else if (key.Equals(TEXT("Frames"), ESearchCase::IgnoreCase))
+		{
+			frames = FCString::Atoi(*value);
+		}
+	}
+	if (counts.Num() == 0 || scenarios.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SymplMovementBenchmark: Nothing to run."));
+		return;
+	}
+	SymplMovementBenchmark::Running = MakeShared<FSymplMovementBenchmark>(World, counts, scenarios, frames, bQuit);
+	SymplMovementBenchmark::Running->Start();
+}
+
+static void SymplBenchmarkSimCommand(const TArray<FString>& Args)
+{
+	int32 count = 10000;
+	int32 steps = 600;
+	for (const FString& arg : Args)
+	{
+		FParse::Value(*arg, TEXT("Count="), count);
+		FParse::Value(*arg, TEXT("Steps="), steps);
+	}
+	TArray<FSymplMovementBenchmark::FResult> results;
+	results.Add(FSymplMovementBenchmark::RunSimulation(FMath::Max(count, 1), FMath::Max(steps, 1)));
+	UE_LOG(LogTemp, Display, TEXT("SymplMovementBenchmark: Wrote %s"), *FSymplMovementBenchmark::WriteResults(results));
+}
+
+static void SymplBenchmarkRollbackCommand(const TArray<FString>& Args)
+{
+	int32 count = 8;
+	int32 steps = 600;
+	int32 frames = 8;
+	for (const FString& arg : Args)
+	{
+		FParse::Value(*arg, TEXT("Count="), count);
+		FParse::Value(*arg, TEXT("Steps="), steps);
+		FParse::Value(*arg, TEXT("Frames="), frames);
+	}
+	TArray<FSymplMovementBenchmark::FResult> results;
+	results.Add(FSymplMovementBenchmark::RunRollback(FMath::Max(count, 1), FMath::Max(steps, 1), FMath::Max(frames, 1)));
+	UE_LOG(LogTemp, Display, TEXT("SymplMovementBenchmark: Wrote %s"), *FSymplMovementBenchmark::WriteResults(results));
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GSymplBenchmarkCommand(
+	TEXT("Sympl.Benchmark"),
+	TEXT("Spawn pawns with advanced movement components in scripted scenarios and write tick, trace, rpc and memory results to Saved/Profiling/SymplMovement.\n")
+	TEXT("Args: Counts=10,100,1000,5000 Scenarios=Idle,Walk,Sprint,WallJump,Dash,Jetpack,Parachute Frames=300 Quit"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SymplBenchmarkCommand));
+
+static FAutoConsoleCommand GSymplBenchmarkSimCommand(
+	TEXT("Sympl.BenchmarkSim"),
+	TEXT("Step the movement simulation core without a world and write the results to Saved/Profiling/SymplMovement.\n")
+	TEXT("Args: Count=10000 Steps=600"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&SymplBenchmarkSimCommand));
+
+static FAutoConsoleCommand GSymplBenchmarkRollbackCommand(
+	TEXT("Sympl.BenchmarkRollback"),
+	TEXT("Step the simulation core at 60 Hz, rewinding and resimulating Frames ticks every tick, and write the results to Saved/Profiling/SymplMovement.\n")
+	TEXT("Args: Count=8 Steps=600 Frames=8"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&SymplBenchmarkRollbackCommand));
+
+#endif
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SymplMovementConfig.h"
+
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+void USymplMovementConfig::SetTuning(const FSymplMovementTuning& InTuning)
+{
+	Tuning = InTuning;
+	OnTuningChanged.Broadcast(this);
+}
+
+bool USymplMovementConfig::SetTuningValue(FName Property, double Value)
+{
+	if (!FSymplMovementTuningOverride(Property, Value).Apply(Tuning))
+	{
+		return false;
+	}
+	OnTuningChanged.Broadcast(this);
+	return true;
+}
+
+TArray<FName> USymplMovementConfig::GetTuningPropertyNames()
+{
+	TArray<FName> names;
+	for (TFieldIterator<FProperty> it(FSymplMovementTuning::StaticStruct()); it; ++it)
+	{
+		if (FSymplMovementTuning::GetPerSecondName(it->GetFName()).IsNone())
+		{
+			names.Add(it->GetFName());
+		}
+	}
+	return names;
+}
+
+#if WITH_EDITOR
+void USymplMovementConfig::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	//Retune components in PIE without restarting.
+	OnTuningChanged.Broadcast(this);
+}
+#endif
+
+#if WITH_EDITOR
+//Sympl.SetTuning Config=DA_Movement MaxDashTime=2 DashForce=1800
+static void SymplSetTuningCommand(const TArray<FString>& Args)
+{
+	FString configName;
+	TArray<TPair<FName, double>> values;
+	for (const FString& arg : Args)
+	{
+		FString key, value;
+		if (!arg.Split(TEXT("="), &key, &value))
+		{
+			continue;
+		}
+		if (key.Equals(TEXT("Config"), ESearchCase::IgnoreCase))
+		{
+			configName = value;
+		}
+		else
+		{
+			values.Emplace(FName(*key), FCString::Atod(*value));
+		}
+	}
+	int32 configs = 0;
+	for (TObjectIterator<USymplMovementConfig> it(RF_NoFlags); it; ++it)
+	{
+		//Config=Default retunes components that don't have a config.
+		const bool bMatches = configName.IsEmpty() ? !it->HasAnyFlags(RF_ClassDefaultObject)
+			: configName.Equals(TEXT("Default"), ESearchCase::IgnoreCase) ? it->HasAnyFlags(RF_ClassDefaultObject) : it->GetName().Equals(configName, ESearchCase::IgnoreCase);
+		if (!bMatches)
+		{
+			continue;
+		}
+		FSymplMovementTuning tuning = it->Tuning;
+		for (const TPair<FName, double>& value : values)
+		{
+			if (!FSymplMovementTuningOverride(value.Key, value.Value).Apply(tuning))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Sympl.SetTuning: Unknown tuning property %s."), *value.Key.ToString());
+			}
+		}
+		it->SetTuning(tuning);
+		configs++;
+	}
+	UE_LOG(LogTemp, Display, TEXT("Sympl.SetTuning: Retuned %d configs."), configs);
+}
+
+static FAutoConsoleCommand GSymplSetTuningCommand(
+	TEXT("Sympl.SetTuning"),
+	TEXT("Change movement tuning on loaded configs and apply it to live components. Editor only, the change is not replicated.\n")
+	TEXT("Args: Config=<asset name, Default for components without a config, or omit for every asset> <Property>=<Value> ..."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&SymplSetTuningCommand));
+#endif
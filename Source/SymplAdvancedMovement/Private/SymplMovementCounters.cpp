@@ -0,0 +1,10 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SymplMovementCounters.h"
+
+FSymplMovementCounters& FSymplMovementCounters::Get()
+{
+	static FSymplMovementCounters counters;
+	return counters;
+}
@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SymplMovementModeStack.h"
+
+FSymplMovementModeStack::FSymplMovementModeStack()
+{
+	Reset();
+}
+
+void FSymplMovementModeStack::Push(ESymplMovementState State, EAdvancedMovementMode Mode)
+{
+	//A state only ever has one entry, so this can't overflow.
+	Remove(State);
+	check(Num < Capacity);
+	Entries[Num].State = State;
+	Entries[Num].Mode = Mode;
+	Num++;
+}
+
+bool FSymplMovementModeStack::Remove(ESymplMovementState State)
+{
+	for (int32 i = Num - 1; i >= 0; i--)
+	{
+		if (Entries[i].State == State)
+		{
+			const bool bWasTop = i == Num - 1;
+			//Close the gap, keeping the order of the rest.
+			for (int32 j = i; j < Num - 1; j++)
+			{
+				Entries[j] = Entries[j + 1];
+			}
+			Num--;
+			return bWasTop;
+		}
+	}
+	return false;
+}
+
+void FSymplMovementModeStack::Reset(EAdvancedMovementMode InBaseMode)
+{
+	BaseMode = InBaseMode;
+	Num = 0;
+}
+
+void FSymplMovementModeStack::Serialize(FArchive& Ar)
+{
+	uint8 base = (uint8)BaseMode;
+	uint8 num = (uint8)Num;
+	Ar << base << num;
+	if (Ar.IsLoading())
+	{
+		if (num > Capacity)
+		{
+			Ar.SetError();
+			return;
+		}
+		BaseMode = (EAdvancedMovementMode)base;
+		Num = num;
+	}
+	for (int32 i = 0; i < Num; i++)
+	{
+		uint8 state = (uint8)Entries[i].State;
+		uint8 mode = (uint8)Entries[i].Mode;
+		Ar << state << mode;
+		if (Ar.IsLoading())
+		{
+			if (state >= (uint8)ESymplMovementState::Max)
+			{
+				Ar.SetError();
+				Num = 0;
+				return;
+			}
+			Entries[i].State = (ESymplMovementState)state;
+			Entries[i].Mode = (EAdvancedMovementMode)mode;
+		}
+	}
+}
@@ -0,0 +1,335 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SymplMovementReplay.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Algo/BinarySearch.h"
+#include "SymplMovementStats.h"
+
+//Records are collected into chunks of about this size before they are handed to the writer.
+static constexpr int32 ReplayChunkSize = 16 * 1024;
+
+void SymplMovementReplay::Encode(const uint8* Raw, int32 RawSize, TArray<uint8>& Out)
+{
+	//Pairs of (zero count, literal count) followed by the literals.
+	int32 i = 0;
+	while (i < RawSize)
+	{
+		int32 zeros = 0;
+		while (i < RawSize && Raw[i] == 0 && zeros < MAX_uint8)
+		{
+			zeros++;
+			i++;
+		}
+		const int32 start = i;
+		int32 literals = 0;
+		//A single zero is cheaper as a literal than as a new pair.
+		while (i < RawSize && literals < MAX_uint8 && !(Raw[i] == 0 && (i + 1 >= RawSize || Raw[i + 1] == 0)))
+		{
+			literals++;
+			i++;
+		}
+		Out.Add((uint8)zeros);
+		Out.Add((uint8)literals);
+		Out.Append(Raw + start, literals);
+	}
+}
+
+bool SymplMovementReplay::Decode(const uint8* Encoded, int32 EncodedSize, uint8* Raw, int32 RawSize)
+{
+	int32 in = 0;
+	int32 out = 0;
+	while (in + 2 <= EncodedSize)
+	{
+		const int32 zeros = Encoded[in];
+		const int32 literals = Encoded[in + 1];
+		in += 2;
+		if (out + zeros + literals > RawSize || in + literals > EncodedSize)
+		{
+			return false;
+		}
+		FMemory::Memzero(Raw + out, zeros);
+		out += zeros;
+		FMemory::Memcpy(Raw + out, Encoded + in, literals);
+		out += literals;
+		in += literals;
+	}
+	return in == EncodedSize && out == RawSize;
+}
+
+FString SymplMovementReplay::GetReplayPath(const FString& Name)
+{
+	if (!FPaths::IsRelative(Name))
+	{
+		return Name;
+	}
+	return FPaths::ProjectSavedDir() / TEXT("Replays") / TEXT("SymplMovement") / FPaths::SetExtension(Name, TEXT("smr"));
+}
+
+FSymplMovementReplayWriter::FSymplMovementReplayWriter()
+	: Pipe(TEXT("SymplMovementReplayWriter"))
+{
+}
+
+FSymplMovementReplayWriter::~FSymplMovementReplayWriter()
+{
+	Close();
+}
+
+bool FSymplMovementReplayWriter::Open(const FString& Path)
+{
+	Close();
+	IPlatformFile& platformFile = FPlatformFileManager::Get().GetPlatformFile();
+	platformFile.CreateDirectoryTree(*FPaths::GetPath(Path));
+	IFileHandle* handle = platformFile.OpenWrite(*Path);
+	if (!handle)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SymplMovementReplay: Can't open %s for writing."), *Path);
+		return false;
+	}
+	FileHandle = MakeShareable(handle);
+	return true;
+}
+
+void FSymplMovementReplayWriter::Write(TArray<uint8>&& Chunk)
+{
+	if (!FileHandle.IsValid() || Chunk.Num() == 0)
+	{
+		return;
+	}
+	//The pipe runs the writes one at a time, in order.
+	LastWrite = Pipe.Launch(TEXT("SymplMovementReplayWrite"), [FileHandle = FileHandle, Chunk = MoveTemp(Chunk)]()
+	{
+		FileHandle->Write(Chunk.GetData(), Chunk.Num());
+	});
+}
+
+void FSymplMovementReplayWriter::Close()
+{
+	if (!FileHandle.IsValid())
+	{
+		return;
+	}
+	LastWrite.Wait();
+	LastWrite = UE::Tasks::FTask();
+	FileHandle->Flush();
+	FileHandle.Reset();
+}
+
+FSymplMovementReplayRecorder::FSymplMovementReplayRecorder()
+{
+	KeyframeInterval = 1.f;
+	FullKeyframeInterval = 30;
+	KeyframesSinceFull = 0;
+	LastKeyframeTime = 0.f;
+	LastFlags = 0;
+	LastMode = EAdvancedMovementMode::ENONE;
+	RawBytes = 0;
+	WrittenBytes = 0;
+}
+
+FSymplMovementReplayRecorder::~FSymplMovementReplayRecorder()
+{
+	Stop();
+}
+
+bool FSymplMovementReplayRecorder::Start(const FString& Path, double InKeyframeInterval, int32 InFullKeyframeInterval)
+{
+	Stop();
+	if (!Writer.Open(Path))
+	{
+		return false;
+	}
+	KeyframeInterval = FMath::Max(InKeyframeInterval, 0.0);
+	FullKeyframeInterval = FMath::Max(InFullKeyframeInterval, 1);
+	LastKeyframe.Reset();
+	RawBytes = 0;
+	WrittenBytes = 0;
+
+	Chunk.Reset(ReplayChunkSize);
+	FMemoryWriter writer(Chunk, false, true);
+	uint32 magic = SymplMovementReplay::Magic;
+	uint8 formatVersion = SymplMovementReplay::FormatVersion;
+	uint8 snapshotVersion = FSymplMovementSnapshot::Version;
+	writer << magic << formatVersion << snapshotVersion;
+	return true;
+}
+
+void FSymplMovementReplayRecorder::Record(double Time, const FSymplMovementSnapshotState& State)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+	const bool bTransition = LastKeyframe.Num() == 0 || State.RuntimeState.MovementStateFlags != LastFlags || State.RuntimeState.CurrentMovementMode != LastMode;
+	if (bTransition || Time - LastKeyframeTime >= KeyframeInterval)
+	{
+		WriteKeyframe(bTransition ? SymplMovementReplay::ERecordType::Transition : SymplMovementReplay::ERecordType::Keyframe, Time, State);
+	}
+}
+
+void FSymplMovementReplayRecorder::WriteKeyframe(SymplMovementReplay::ERecordType Type, double Time, const FSymplMovementSnapshotState& State)
+{
+	SYMPL_SCOPE(ReplayKeyframe);
+	Current.Write(State, Time);
+	const TArray<uint8>& raw = Current.Data;
+	//The mode stack changes the size, and a delta needs the same layout.
+	const bool bFull = LastKeyframe.Num() != raw.Num() || KeyframesSinceFull + 1 >= FullKeyframeInterval;
+	const uint8* source = raw.GetData();
+	if (!bFull)
+	{
+		Delta.SetNumUninitialized(raw.Num());
+		for (int32 i = 0; i < raw.Num(); i++)
+		{
+			Delta[i] = raw[i] ^ LastKeyframe[i];
+		}
+		source = Delta.GetData();
+	}
+	KeyframesSinceFull = bFull ? 0 : KeyframesSinceFull + 1;
+
+	const int32 recordStart = Chunk.Num();
+	uint8 type = (uint8)Type;
+	uint8 full = bFull ? 1 : 0;
+	uint16 rawSize = (uint16)raw.Num();
+	uint16 encodedSize = 0;
+	double time = Time;
+	{
+		FMemoryWriter writer(Chunk, false, true);
+		writer << type << time << full << rawSize << encodedSize;
+	}
+	const int32 encodedStart = Chunk.Num();
+	SymplMovementReplay::Encode(source, raw.Num(), Chunk);
+	encodedSize = (uint16)(Chunk.Num() - encodedStart);
+	FMemory::Memcpy(Chunk.GetData() + encodedStart - sizeof(uint16), &encodedSize, sizeof(uint16));
+
+	RawBytes += raw.Num();
+	WrittenBytes += Chunk.Num() - recordStart;
+	LastKeyframe = raw;
+	LastKeyframeTime = Time;
+	LastFlags = State.RuntimeState.MovementStateFlags;
+	LastMode = State.RuntimeState.CurrentMovementMode;
+
+	if (Chunk.Num() >= ReplayChunkSize)
+	{
+		Flush();
+	}
+}
+
+void FSymplMovementReplayRecorder::Flush()
+{
+	Writer.Write(MoveTemp(Chunk));
+	Chunk.Reset(ReplayChunkSize);
+}
+
+void FSymplMovementReplayRecorder::Stop()
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+	Flush();
+	Writer.Close();
+	UE_LOG(LogTemp, Log, TEXT("SymplMovementReplay: Recorded %lld bytes of keyframes into %lld bytes."), RawBytes, WrittenBytes);
+}
+
+bool FSymplMovementReplayPlayer::Load(const FString& Path)
+{
+	Frames.Reset();
+	TArray<uint8> file;
+	if (!FFileHelper::LoadFileToArray(file, *Path))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SymplMovementReplay: Can't read %s."), *Path);
+		return false;
+	}
+	FMemoryReader reader(file);
+	uint32 magic = 0;
+	uint8 formatVersion = 0;
+	uint8 snapshotVersion = 0;
+	reader << magic << formatVersion << snapshotVersion;
+	if (reader.IsError() || magic != SymplMovementReplay::Magic || formatVersion != SymplMovementReplay::FormatVersion || snapshotVersion != FSymplMovementSnapshot::Version)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SymplMovementReplay: %s is not a movement replay of this version."), *Path);
+		return false;
+	}
+
+	FSymplMovementSnapshot keyframe;
+	TArray<uint8> previous;
+	while (!reader.AtEnd())
+	{
+		uint8 type = 0;
+		double time = 0.f;
+		uint8 full = 0;
+		uint16 rawSize = 0;
+		uint16 encodedSize = 0;
+		reader << type << time << full << rawSize << encodedSize;
+		const int64 encodedStart = reader.Tell();
+		if (reader.IsError() || encodedStart + encodedSize > file.Num() || (!full && previous.Num() != rawSize))
+		{
+			break;
+		}
+		keyframe.Data.SetNumUninitialized(rawSize);
+		if (!SymplMovementReplay::Decode(file.GetData() + encodedStart, encodedSize, keyframe.Data.GetData(), rawSize))
+		{
+			break;
+		}
+		reader.Seek(encodedStart + encodedSize);
+		if (!full)
+		{
+			for (int32 i = 0; i < rawSize; i++)
+			{
+				keyframe.Data[i] ^= previous[i];
+			}
+		}
+		previous = keyframe.Data;
+
+		FFrame& frame = Frames.AddDefaulted_GetRef();
+		frame.Time = time;
+		frame.Type = (SymplMovementReplay::ERecordType)type;
+		double savedTime = 0.f;
+		if (!keyframe.Read(frame.State, savedTime))
+		{
+			Frames.Pop();
+			break;
+		}
+	}
+	if (!reader.AtEnd())
+	{
+		//A recording that wasn't stopped cleanly can end in a partial record. Keep what we could read.
+		UE_LOG(LogTemp, Warning, TEXT("SymplMovementReplay: %s is corrupt after %d keyframes."), *Path, Frames.Num());
+	}
+	return Frames.Num() > 0;
+}
+
+bool FSymplMovementReplayPlayer::Evaluate(double Time, FSymplMovementSnapshotState& State) const
+{
+	const int32 index = Algo::UpperBoundBy(Frames, Time, &FFrame::Time) - 1;
+	if (index < 0)
+	{
+		return false;
+	}
+	State = Frames[index].State;
+	//A transition changes state at its own time, blending into it would start the new state early.
+	if (index + 1 < Frames.Num() && Frames[index + 1].Type == SymplMovementReplay::ERecordType::Keyframe)
+	{
+		const FFrame& next = Frames[index + 1];
+		const double span = next.Time - Frames[index].Time;
+		if (span > KINDA_SMALL_NUMBER)
+		{
+			const double alpha = FMath::Clamp((Time - Frames[index].Time) / span, 0.0, 1.0);
+			FSymplMovementRuntimeState& runtime = State.RuntimeState;
+			const FSymplMovementRuntimeState& target = next.State.RuntimeState;
+			runtime.CurrentVelocity = FMath::Lerp(runtime.CurrentVelocity, target.CurrentVelocity, alpha);
+			runtime.CurrentSpeed = FMath::Lerp(runtime.CurrentSpeed, target.CurrentSpeed, alpha);
+			runtime.CurrentSlopeAngle = FMath::Lerp(runtime.CurrentSlopeAngle, target.CurrentSlopeAngle, alpha);
+			runtime.CurrentSlopeSpeedScalar = FMath::Lerp(runtime.CurrentSlopeSpeedScalar, target.CurrentSlopeSpeedScalar, alpha);
+			runtime.ForwardInput = FMath::Lerp(runtime.ForwardInput, target.ForwardInput, alpha);
+			runtime.RightInput = FMath::Lerp(runtime.RightInput, target.RightInput, alpha);
+			runtime.UpInput = FMath::Lerp(runtime.UpInput, target.UpInput, alpha);
+		}
+	}
+	return true;
+}
@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SymplMovementRollback.h"
+
+void FSymplMovementRollbackBuffer::Init(int32 InCapacity)
+{
+	Frames.SetNum(FMath::Max(InCapacity, 1));
+	Reset();
+}
+
+void FSymplMovementRollbackBuffer::Reset()
+{
+	for (FSymplMovementRollbackFrame& frame : Frames)
+	{
+		frame.Frame = INDEX_NONE;
+	}
+}
+
+FSymplMovementRollbackFrame& FSymplMovementRollbackBuffer::Add(int32 Frame)
+{
+	check(Frame >= 0 && Frames.Num() > 0);
+	FSymplMovementRollbackFrame& slot = Frames[Frame % Frames.Num()];
+	slot.Frame = Frame;
+	return slot;
+}
+
+FSymplMovementRollbackFrame* FSymplMovementRollbackBuffer::Find(int32 Frame)
+{
+	if (Frame < 0 || Frames.Num() <= 0)
+	{
+		return nullptr;
+	}
+	FSymplMovementRollbackFrame& slot = Frames[Frame % Frames.Num()];
+	return slot.Frame == Frame ? &slot : nullptr;
+}
+
+const FSymplMovementRollbackFrame* FSymplMovementRollbackBuffer::Find(int32 Frame) const
+{
+	return const_cast<FSymplMovementRollbackBuffer*>(this)->Find(Frame);
+}
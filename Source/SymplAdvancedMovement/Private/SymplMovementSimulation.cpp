@@ -0,0 +1,204 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SymplMovementSimulation.h"
+
+#include "SymplMovementStateMachine.h"
+#include "SymplMovementStats.h"
+
+namespace SymplMovementSimulation
+{
+	bool CanSlide(const FSymplMovementSimConfig& Config, const FSymplMovementSimState& State, const FSymplMovementSimInput& Input)
+	{
+		//Check slide times, angles and velocity.
+		if (!Config.bCanSlide && !State.Has(ESymplMovementSimFlags::Prone))
+		{
+			return false;
+		}
+		if (Config.MaxSlideTime >= 0.f && FSymplMovementSimState::GetElapsed(State.SlideStartTime, Input.Time) >= Config.MaxSlideTime)
+		{
+			return false;
+		}
+		if (Input.Velocity.Size() >= Config.RequiredSlideSpeed)
+		{
+			if (Config.bIgnoreSlideAngle)
+			{
+				return true;
+			}
+			if (Input.bIsCharacter && !Input.bFalling)
+			{
+				return Input.FloorAngle >= Config.RequiredSlideAngle;
+			}
+		}
+		return false;
+	}
+
+	bool CanDash(const FSymplMovementSimConfig& Config, const FSymplMovementSimState& State, double Time)
+	{
+		return SymplMovementStateMachine::CanEnter(State.Flags, ESymplMovementState::Dashing) && FSymplMovementSimState::GetElapsed(State.DashStartTime, Time) <= Config.MaxDashTime;
+	}
+
+	bool CanBlink(const FSymplMovementSimConfig& Config, const FSymplMovementSimState& State, double Time)
+	{
+		return SymplMovementStateMachine::CanEnter(State.Flags, ESymplMovementState::Blinking) && FSymplMovementSimState::GetElapsed(State.BlinkStartTime, Time) <= Config.MaxBlinkTime;
+	}
+
+	bool CanRoll(const FSymplMovementSimConfig& Config, const FSymplMovementSimState& State, double Time)
+	{
+		return SymplMovementStateMachine::CanEnter(State.Flags, ESymplMovementState::Rolling) && FSymplMovementSimState::GetElapsed(State.RollStartTime, Time) <= Config.MaxRollTime;
+	}
+
+	bool CanHover(const FSymplMovementSimConfig& Config, const FSymplMovementSimState& State, double Time)
+	{
+		return Config.bEnableHover && FSymplMovementSimState::GetElapsed(State.HoverStartTime, Time) < Config.MaxHoverTime;
+	}
+
+	FSymplMovementSimResult Step(const FSymplMovementSimConfig& Config, const FSymplMovementSimState& State, const FSymplMovementSimInput& Input, double DeltaTime, const ISymplMovementSimQueries& Queries)
+	{
+		SYMPL_SCOPE(SimulationStep);
+		FSymplMovementSimResult result;
+		FSymplMovementSimState& state = result.State;
+		state = State;
+		state.Velocity = Input.Velocity;
+
+		//Slope.
+		if (Config.bAdjustSpeedToSlope)
+		{
+			state.SlopeAngle = Queries.QuerySlopeAngle();
+			state.SlopeSpeedScalar = Queries.QuerySlopeSpeedScalar(state.SlopeAngle);
+		}
+
+		//Speed only changes with the movement mode.
+		double speed = 0.f;
+		if (Config.bManageCustomSpeed && state.MovementMode != state.LastMovementMode && Queries.QueryModeSpeed(state.MovementMode, speed))
+		{
+			state.Speed = speed * state.SlopeSpeedScalar;
+			result.Events |= ESymplMovementSimEvents::SpeedChanged;
+		}
+
+		const FVector forward = Input.Rotation.GetForwardVector();
+		//Owners that aren't characters move by offsets OffsetMoveRate times a second.
+		const double offsetScale = Config.OffsetMoveRate * DeltaTime;
+
+		//Slide on server only.
+		if (Input.bHasAuthority)
+		{
+			if (Config.bCanSlide)
+			{
+				if (state.Has(ESymplMovementSimFlags::Sliding) && CanSlide(Config, state, Input))
+				{
+					state.MovementType = EMovementAnimType::ESLIDING;
+					//A force for characters, their movement integrates it once per frame.
+					result.SlideForce = forward * Config.SlideForce * (Input.bIsCharacter ? Input.FrameFraction : offsetScale);
+					result.Events |= ESymplMovementSimEvents::Sliding;
+				}
+			}
+			else
+			{
+				state.MovementType = EMovementAnimType::ENONE;
+				result.Events |= ESymplMovementSimEvents::SlideReset;
+			}
+		}
+
+		//Dashing.
+		if (state.Has(ESymplMovementSimFlags::Dashing) && CanDash(Config, state, Input.Time))
+		{
+			result.DashLaunch = state.DashDirection * (Input.bIsCharacter ? Config.DashForce : state.Speed * offsetScale);
+			result.Events |= ESymplMovementSimEvents::Dashing;
+		}
+		else if (state.Has(ESymplMovementSimFlags::Dashing))
+		{
+			result.Events |= ESymplMovementSimEvents::DashEnded;
+		}
+
+		//Blinking.
+		if (state.Has(ESymplMovementSimFlags::Blinking) && CanBlink(Config, state, Input.Time))
+		{
+			result.BlinkLaunch = state.BlinkDirection * (Input.bIsCharacter ? Config.BlinkForce : state.Speed * offsetScale);
+			result.Events |= ESymplMovementSimEvents::Blinking;
+		}
+		else if (state.Has(ESymplMovementSimFlags::Blinking))
+		{
+			result.Events |= ESymplMovementSimEvents::BlinkEnded;
+		}
+
+		//Rolling.
+		if (state.Has(ESymplMovementSimFlags::Rolling) && CanRoll(Config, state, Input.Time))
+		{
+			result.RollInput = state.RollDirection * (Input.bIsCharacter ? Config.RollForce : state.Speed * offsetScale);
+			result.Events |= ESymplMovementSimEvents::Rolling;
+		}
+		else if (state.Has(ESymplMovementSimFlags::Rolling))
+		{
+			result.Events |= ESymplMovementSimEvents::RollEnded;
+		}
+
+		//Hovering.
+		if (state.Has(ESymplMovementSimFlags::Hovering) && !CanHover(Config, state, Input.Time))
+		{
+			result.Events |= ESymplMovementSimEvents::HoverEnded;
+		}
+
+		//Zero g moves along the input relative to the owner.
+		if (state.Has(ESymplMovementSimFlags::ZeroG))
+		{
+			result.ZeroGDelta = Input.Rotation.RotateVector(Input.MoveInput.GetClampedToMaxSize(1.f)) * state.Speed * DeltaTime;
+			result.Events |= ESymplMovementSimEvents::ZeroGMoved;
+		}
+
+		//Jetpack. Fuel only changes rate on events and is evaluated from the meter in between.
+		FSymplResourceMeter& fuel = state.JetpackFuel;
+		if (fuel.MaxValue != Config.MaxJetpackFuel)
+		{
+			fuel.SetMaxValue(Input.Time, Config.MaxJetpackFuel);
+		}
+		double fuelRate = Config.bRestoreJetpackFuelWhenInactive ? Config.JetpackRefuelPerSecond : 0.f;
+		//Starting needs RequiredFuelForJetpack, but once draining the jetpack runs until the tank is empty.
+		//Otherwise fuel hovering around the requirement would switch between draining and refueling every step.
+		const double fuelValue = fuel.GetValue(Input.Time);
+		const bool bHasFuel = fuel.Rate < 0.f ? fuelValue > 0.f : fuelValue >= Config.RequiredFuelForJetpack;
+		if (state.Has(ESymplMovementSimFlags::JetpackActive) && bHasFuel)
+		{
+			//Integrated over the step.
+			result.JetpackAcceleration = FVector::UpVector * Config.JetpackAcceleration;
+			result.JetpackVelocity = state.Velocity + result.JetpackAcceleration * DeltaTime;
+			result.JetpackDelta = result.JetpackVelocity * DeltaTime;
+			result.JetpackPhysicsAcceleration = result.JetpackAcceleration * Input.FrameFraction;
+			state.Velocity = result.JetpackVelocity;
+			result.Events |= ESymplMovementSimEvents::Jetpacking;
+			fuelRate = -Config.JetpackDrainPerSecond;
+		}
+		else if (state.Has(ESymplMovementSimFlags::JetpackActive))
+		{
+			result.Events |= ESymplMovementSimEvents::JetpackDepleted;
+		}
+		if (fuel.Rate != fuelRate)
+		{
+			fuel.SetRate(Input.Time, fuelRate);
+			result.Events |= ESymplMovementSimEvents::FuelChanged;
+		}
+
+		//Sprint stamina.
+		if (Config.bUseSprintStamina)
+		{
+			FSymplResourceMeter& stamina = state.SprintStamina;
+			if (stamina.MaxValue != Config.MaxSprintStamina)
+			{
+				stamina.SetMaxValue(Input.Time, Config.MaxSprintStamina);
+			}
+			const bool bSprinting = state.Has(ESymplMovementSimFlags::Sprinting);
+			const double staminaRate = bSprinting ? -Config.SprintStaminaDrainRate : Config.SprintStaminaRegenRate;
+			if (stamina.Rate != staminaRate)
+			{
+				stamina.SetRate(Input.Time, staminaRate);
+				result.Events |= ESymplMovementSimEvents::StaminaChanged;
+			}
+			if (bSprinting && stamina.IsEmpty(Input.Time))
+			{
+				result.Events |= ESymplMovementSimEvents::StaminaDepleted;
+			}
+		}
+
+		return result;
+	}
+}
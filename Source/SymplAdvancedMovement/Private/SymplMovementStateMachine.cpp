@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SymplMovementStateMachine.h"
+
+namespace SymplMovementStateMachine
+{
+	//Check the table at compile time so a bad row can't ship.
+	constexpr bool IsTableValid()
+	{
+		ESymplMovementSimFlags seen = ESymplMovementSimFlags::None;
+		for (int32 i = 0; i < (int32)ESymplMovementState::Max; i++)
+		{
+			const FSymplMovementStateRule& rule = Rules[i];
+			//Every state owns exactly one flag that no other state owns.
+			if (rule.Flag == ESymplMovementSimFlags::None || (seen & rule.Flag) != ESymplMovementSimFlags::None)
+			{
+				return false;
+			}
+			//A state can't block or exit itself.
+			if ((rule.BlockedBy & rule.Flag) != ESymplMovementSimFlags::None || (rule.Exits & rule.Flag) != ESymplMovementSimFlags::None)
+			{
+				return false;
+			}
+			//Entering a state can't exit something that blocks it.
+			if ((rule.BlockedBy & rule.Exits) != ESymplMovementSimFlags::None)
+			{
+				return false;
+			}
+			seen |= rule.Flag;
+		}
+		return seen == AllStates;
+	}
+	static_assert(IsTableValid(), "Invalid movement state transition table.");
+
+	const TCHAR* GetStateName(ESymplMovementState State)
+	{
+		switch (State)
+		{
+		case ESymplMovementState::Dashing: return TEXT("Dashing");
+		case ESymplMovementState::Blinking: return TEXT("Blinking");
+		case ESymplMovementState::Rolling: return TEXT("Rolling");
+		case ESymplMovementState::Hovering: return TEXT("Hovering");
+		case ESymplMovementState::Sliding: return TEXT("Sliding");
+		case ESymplMovementState::Crouching: return TEXT("Crouching");
+		case ESymplMovementState::Prone: return TEXT("Prone");
+		case ESymplMovementState::Sprinting: return TEXT("Sprinting");
+		case ESymplMovementState::Jetpack: return TEXT("Jetpack");
+		case ESymplMovementState::ZeroG: return TEXT("ZeroG");
+		case ESymplMovementState::Parachuting: return TEXT("Parachuting");
+		default: return TEXT("None");
+		}
+	}
+}
@@ -0,0 +1,10 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SymplMovementStats.h"
+
+#if SYMPL_MOVEMENT_STATS
+
+UE_TRACE_CHANNEL_DEFINE(SymplMovementChannel);
+
+#endif
@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SymplNetStatsTracker.h"
+
+FSymplNetStatsTracker::FSymplNetStatsTracker()
+{
+	Reset();
+}
+
+void FSymplNetStatsTracker::RecordRpc(ESymplMovementRpc Rpc, int32 Bytes, bool bReliable, float ReliableBufferPressure)
+{
+	if (Rpc >= ESymplMovementRpc::EMAX)
+	{
+		return;
+	}
+	FCounter& counter = Rpcs[(int32)Rpc];
+	counter.Count++;
+	counter.Bytes += Bytes;
+	counter.WindowCount++;
+	counter.WindowBytes += Bytes;
+	counter.WindowPressure = FMath::Max(counter.WindowPressure, ReliableBufferPressure);
+	counter.bReliable = bReliable;
+}
+
+void FSymplNetStatsTracker::InitProperties(const TArray<FName>& Names)
+{
+	PropertyNames = Names;
+	Properties.Reset();
+	Properties.SetNum(Names.Num());
+}
+
+void FSymplNetStatsTracker::RecordProperty(int32 Index, int32 Bytes)
+{
+	if (!Properties.IsValidIndex(Index))
+	{
+		return;
+	}
+	FCounter& counter = Properties[Index];
+	counter.Count++;
+	counter.Bytes += Bytes;
+	counter.WindowCount++;
+	counter.WindowBytes += Bytes;
+}
+
+void FSymplNetStatsTracker::CloseWindow(FCounter& Counter, double Elapsed)
+{
+	Counter.CountRate = Counter.WindowCount / Elapsed;
+	Counter.ByteRate = Counter.WindowBytes / Elapsed;
+	Counter.Pressure = Counter.WindowPressure;
+	Counter.WindowCount = 0;
+	Counter.WindowBytes = 0;
+	Counter.WindowPressure = 0.f;
+}
+
+void FSymplNetStatsTracker::Update(double Time, double WindowSeconds)
+{
+	if (WindowStart < 0.f)
+	{
+		WindowStart = Time;
+		return;
+	}
+	const double elapsed = Time - WindowStart;
+	if (elapsed < WindowSeconds || elapsed <= 0.f)
+	{
+		return;
+	}
+	for (FCounter& counter : Rpcs)
+	{
+		CloseWindow(counter, elapsed);
+	}
+	for (FCounter& counter : Properties)
+	{
+		CloseWindow(counter, elapsed);
+	}
+	WindowStart = Time;
+}
+
+void FSymplNetStatsTracker::Fill(FSymplMovementNetStats& OutStats) const
+{
+	OutStats = FSymplMovementNetStats();
+	for (int32 i = 0; i < (int32)ESymplMovementRpc::EMAX; i++)
+	{
+		const FCounter& counter = Rpcs[i];
+		if (counter.Count == 0)
+		{
+			continue;
+		}
+		FSymplRpcNetStats& stats = OutStats.Rpcs.AddDefaulted_GetRef();
+		stats.Rpc = (ESymplMovementRpc)i;
+		stats.bReliable = counter.bReliable;
+		stats.Calls = counter.Count;
+		stats.CallsPerSecond = counter.CountRate;
+		stats.Bytes = counter.Bytes;
+		stats.BytesPerSecond = counter.ByteRate;
+		stats.ReliableBufferPressure = counter.Pressure;
+		OutStats.RpcBytesPerSecond += counter.ByteRate;
+	}
+	for (int32 i = 0; i < Properties.Num(); i++)
+	{
+		const FCounter& counter = Properties[i];
+		FSymplPropertyNetStats& stats = OutStats.Properties.AddDefaulted_GetRef();
+		stats.Property = PropertyNames[i];
+		stats.Changes = counter.Count;
+		stats.ChangesPerSecond = counter.CountRate;
+		stats.Bytes = counter.Bytes;
+		stats.BytesPerSecond = counter.ByteRate;
+		OutStats.PropertyBytesPerSecond += counter.ByteRate;
+	}
+}
+
+void FSymplNetStatsTracker::Reset()
+{
+	for (FCounter& counter : Rpcs)
+	{
+		counter = FCounter();
+	}
+	for (FCounter& counter : Properties)
+	{
+		counter = FCounter();
+	}
+	WindowStart = -1.f;
+}
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SymplRpcRateLimiter.h"
+
+FSymplRpcRateLimiter::FSymplRpcRateLimiter()
+{
+	Reset();
+}
+
+bool FSymplRpcRateLimiter::TryConsume(ESymplMovementRpc Rpc, double Time, const FSymplRpcRateLimit& Limit)
+{
+	if (Rpc >= ESymplMovementRpc::EMAX)
+	{
+		return false;
+	}
+	FBucket& bucket = Buckets[(int32)Rpc];
+	//Refill for the time that has passed.
+	if (bucket.Tokens < 0.f)
+	{
+		bucket.Tokens = Limit.Burst;
+	}
+	else
+	{
+		bucket.Tokens = FMath::Min((double)Limit.Burst, bucket.Tokens + (Time - bucket.LastTime) * Limit.CallsPerSecond);
+	}
+	bucket.LastTime = Time;
+	if (bucket.Tokens < 1.f)
+	{
+		AddRejected(Rpc);
+		return false;
+	}
+	bucket.Tokens -= 1.f;
+	return true;
+}
+
+void FSymplRpcRateLimiter::AddRejected(ESymplMovementRpc Rpc)
+{
+	if (Rpc < ESymplMovementRpc::EMAX)
+	{
+		Buckets[(int32)Rpc].Rejected++;
+	}
+	TotalRejected++;
+}
+
+int32 FSymplRpcRateLimiter::GetRejectedCount(ESymplMovementRpc Rpc) const
+{
+	return Rpc < ESymplMovementRpc::EMAX ? Buckets[(int32)Rpc].Rejected : 0;
+}
+
+void FSymplRpcRateLimiter::Reset()
+{
+	for (FBucket& bucket : Buckets)
+	{
+		bucket.Tokens = -1.f;
+		bucket.LastTime = 0.f;
+		bucket.Rejected = 0;
+	}
+	TotalRejected = 0;
+}
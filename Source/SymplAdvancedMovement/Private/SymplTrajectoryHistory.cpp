@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SymplTrajectoryHistory.h"
+
+FSymplTrajectoryHistory::FSymplTrajectoryHistory()
+{
+	Head = 0;
+	Count = 0;
+}
+
+void FSymplTrajectoryHistory::Init(int32 InCapacity)
+{
+	Samples.SetNum(FMath::Max(InCapacity, 1));
+	Reset();
+}
+
+void FSymplTrajectoryHistory::Reset()
+{
+	Head = 0;
+	Count = 0;
+}
+
+void FSymplTrajectoryHistory::Add(const FSymplTrajectorySample& Sample)
+{
+	if (Samples.Num() <= 0)
+	{
+		return;
+	}
+	Samples[Head] = Sample;
+	Head = (Head + 1) % Samples.Num();
+	Count = FMath::Min(Count + 1, Samples.Num());
+}
+
+const FSymplTrajectorySample& FSymplTrajectoryHistory::GetFromNewest(int32 Index) const
+{
+	check(Index >= 0 && Index < Count);
+	return Samples[(Head - 1 - Index + Samples.Num()) % Samples.Num()];
+}
+
+bool FSymplTrajectoryHistory::SampleAtTime(double Time, FSymplTrajectorySample& OutSample) const
+{
+	if (Count <= 0)
+	{
+		return false;
+	}
+	//Newer than our newest sample, use the newest.
+	if (Time >= GetFromNewest(0).Time)
+	{
+		OutSample = GetFromNewest(0);
+		return true;
+	}
+	//Walk back until we find the sample just before Time and blend towards the newer one.
+	for (int32 i = 1; i < Count; i++)
+	{
+		const FSymplTrajectorySample& older = GetFromNewest(i);
+		if (older.Time <= Time)
+		{
+			const FSymplTrajectorySample& newer = GetFromNewest(i - 1);
+			const double alpha = newer.Time > older.Time ? (Time - older.Time) / (newer.Time - older.Time) : 0.f;
+			OutSample = older;
+			OutSample.Time = Time;
+			OutSample.Location = FMath::Lerp(older.Location, newer.Location, alpha);
+			OutSample.Velocity = FMath::Lerp(older.Velocity, newer.Velocity, alpha);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FSymplTrajectoryHistory::FindNewest(bool bGrounded, double BeforeTime, FSymplTrajectorySample& OutSample) const
+{
+	for (int32 i = 0; i < Count; i++)
+	{
+		const FSymplTrajectorySample& sample = GetFromNewest(i);
+		if (sample.Time <= BeforeTime && sample.bGrounded == bGrounded)
+		{
+			OutSample = sample;
+			return true;
+		}
+	}
+	return false;
+}
+
+void FSymplTrajectoryHistory::CopyTo(TArray<FSymplTrajectorySample>& OutSamples) const
+{
+	OutSamples.Reset(Count);
+	for (int32 i = Count - 1; i >= 0; i--)
+	{
+		OutSamples.Add(GetFromNewest(i));
+	}
+}
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && !UE_BUILD_SHIPPING
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include "SymplMovementBenchmark.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSymplMovementBenchmarkSimTest, "SymplAdvancedMovement.Benchmark.Simulation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FSymplMovementBenchmarkSimTest::RunTest(const FString& Parameters)
+{
+	TArray<FSymplMovementBenchmark::FResult> results;
+	results.Add(FSymplMovementBenchmark::RunSimulation(100, 60));
+	results.Add(FSymplMovementBenchmark::RunRollback(10, 60, 8));
+	TestEqual(TEXT("SimCore count"), results[0].Count, 100);
+	TestEqual(TEXT("SimCore steps"), results[0].Frames, 60);
+	TestEqual(TEXT("Rollback count"), results[1].Count, 10);
+	TestEqual(TEXT("Rollback ticks"), results[1].Frames, 60);
+	TestTrue(TEXT("Rollback frames are counted as component memory"), results[1].BytesPerComponent > 0);
+	for (const FSymplMovementBenchmark::FResult& result : results)
+	{
+		TestTrue(*FString::Printf(TEXT("%s times are measured"), *result.Scenario), result.AvgFrameMs >= 0.f && result.MaxFrameMs >= result.AvgFrameMs);
+	}
+
+	const FString path = FSymplMovementBenchmark::WriteResults(results);
+	FString csv;
+	TestTrue(TEXT("Results written"), FFileHelper::LoadFileToString(csv, *path));
+	TestTrue(TEXT("Results have both runs"), csv.Contains(TEXT("\nSimCore,")) && csv.Contains(TEXT("\nRollback,")));
+	TestTrue(TEXT("Json written"), FPaths::FileExists(FPaths::ChangeExtension(path, TEXT("json"))));
+	return true;
+}
+
+//Wait for a benchmark to finish, then check its results.
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FSymplWaitForBenchmarkCommand, TSharedPtr<FSymplMovementBenchmark>, Benchmark, FAutomationTestBase*, Test);
+
+bool FSymplWaitForBenchmarkCommand::Update()
+{
+	if (!Benchmark->IsDone())
+	{
+		return false;
+	}
+	//Each scenario and count, then the simulation core.
+	const TArray<FSymplMovementBenchmark::FResult>& results = Benchmark->GetResults();
+	Test->TestEqual(TEXT("Runs"), results.Num(), 3);
+	for (const FSymplMovementBenchmark::FResult& result : results)
+	{
+		Test->TestTrue(*FString::Printf(TEXT("%s measured frames"), *result.Scenario), result.Frames > 0);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSymplMovementBenchmarkScenarioTest, "SymplAdvancedMovement.Benchmark.Scenarios", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FSymplMovementBenchmarkScenarioTest::RunTest(const FString& Parameters)
+{
+	//The scenarios spawn pawns, so they need a running game world.
+	UWorld* world = nullptr;
+	for (const FWorldContext& context : GEngine->GetWorldContexts())
+	{
+		if ((context.WorldType == EWorldType::Game || context.WorldType == EWorldType::PIE) && context.World())
+		{
+			world = context.World();
+			break;
+		}
+	}
+	if (!world)
+	{
+		AddInfo(TEXT("No game world, run with a map loaded or in PIE to benchmark the scenarios."));
+		return true;
+	}
+	TSharedPtr<FSymplMovementBenchmark> benchmark = MakeShared<FSymplMovementBenchmark>(world, TArray<int32>{ 10 },
+		TArray<FSymplMovementBenchmark::EScenario>{ FSymplMovementBenchmark::EScenario::Idle, FSymplMovementBenchmark::EScenario::Walk }, 30, false);
+	benchmark->Start();
+	ADD_LATENT_AUTOMATION_COMMAND(FSymplWaitForBenchmarkCommand(benchmark, this));
+	return true;
+}
+
+#endif
@@ -0,0 +1,368 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "FSymplMovementSnapshot.h"
+#include "FSymplMovementTuning.h"
+#include "FSymplResourceMeter.h"
+#include "SymplMovementModeStack.h"
+#include "SymplMovementReplay.h"
+#include "SymplMovementRollback.h"
+#include "SymplMovementSimulation.h"
+
+namespace SymplMovementTests
+{
+	//Fixed answers so the sim core runs without a world.
+	class FStubQueries : public ISymplMovementSimQueries
+	{
+
+	public:
+
+		virtual double QuerySlopeAngle() const override { return 0.f; }
+		virtual double QuerySlopeSpeedScalar(double SlopeAngle) const override { return 1.f; }
+		virtual bool QueryModeSpeed(EAdvancedMovementMode Mode, double& OutSpeed) const override
+		{
+			OutSpeed = Mode == EAdvancedMovementMode::ESPRINT ? 1000.f : 600.f;
+			return true;
+		}
+
+	};
+
+	static FSymplMovementSimInput MakeInput(double Time)
+	{
+		FSymplMovementSimInput input;
+		input.MoveInput = FVector(1.f, 0.f, 0.f);
+		input.bIsCharacter = true;
+		input.bHasAuthority = true;
+		input.Time = Time;
+		return input;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSymplMovementSimulationStepTest, "SymplAdvancedMovement.Simulation.Step", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSymplMovementSimulationStepTest::RunTest(const FString& Parameters)
+{
+	const FSymplMovementSimConfig config;
+	const SymplMovementTests::FStubQueries queries;
+
+	//Speed follows a mode change.
+	{
+		FSymplMovementSimState state;
+		state.MovementMode = EAdvancedMovementMode::ESPRINT;
+		state.LastMovementMode = EAdvancedMovementMode::EWALK;
+		const FSymplMovementSimResult result = SymplMovementSimulation::Step(config, state, SymplMovementTests::MakeInput(0.f), 1.f / 60.f, queries);
+		TestTrue(TEXT("Mode change reports SpeedChanged"), result.Has(ESymplMovementSimEvents::SpeedChanged));
+		TestEqual(TEXT("Sprint speed"), result.State.Speed, 1000.0);
+	}
+
+	//The jetpack accelerates over the step and drains fuel.
+	{
+		FSymplMovementSimConfig jetpackConfig;
+		jetpackConfig.JetpackAcceleration = 1000.f;
+		FSymplMovementSimState state;
+		state.Set(ESymplMovementSimFlags::JetpackActive, true);
+		state.JetpackFuel = FSymplResourceMeter(jetpackConfig.MaxJetpackFuel, jetpackConfig.MaxJetpackFuel);
+		const FSymplMovementSimResult result = SymplMovementSimulation::Step(jetpackConfig, state, SymplMovementTests::MakeInput(0.f), .5f, queries);
+		TestTrue(TEXT("Jetpacking"), result.Has(ESymplMovementSimEvents::Jetpacking));
+		TestEqual(TEXT("Jetpack velocity"), result.JetpackVelocity.Z, 500.0);
+		TestEqual(TEXT("Jetpack delta"), result.JetpackDelta.Z, 250.0);
+		TestTrue(TEXT("Fuel starts draining"), result.Has(ESymplMovementSimEvents::FuelChanged));
+		TestEqual(TEXT("Fuel rate"), result.State.JetpackFuel.Rate, -jetpackConfig.JetpackDrainPerSecond);
+		TestEqual(TEXT("Fuel after a second"), result.State.JetpackFuel.GetValue(1.f), jetpackConfig.MaxJetpackFuel - jetpackConfig.JetpackDrainPerSecond);
+	}
+
+	//Holding the jetpack drains the fuel to empty once, then reports it depleted instead of flipping the fuel rate around RequiredFuelForJetpack.
+	{
+		FSymplMovementSimState state;
+		state.Set(ESymplMovementSimFlags::JetpackActive, true);
+		state.JetpackFuel = FSymplResourceMeter(config.RequiredFuelForJetpack * 2.f, config.MaxJetpackFuel);
+		int32 rateChanges = 0;
+		bool bDepleted = false;
+		for (int32 i = 0; i < 60; i++)
+		{
+			const FSymplMovementSimResult result = SymplMovementSimulation::Step(config, state, SymplMovementTests::MakeInput(i / 60.f), 1.f / 60.f, queries);
+			rateChanges += result.Has(ESymplMovementSimEvents::FuelChanged) ? 1 : 0;
+			state = result.State;
+			//The server exits the Jetpack state on JetpackDepleted.
+			if (result.Has(ESymplMovementSimEvents::JetpackDepleted))
+			{
+				bDepleted = true;
+				state.Set(ESymplMovementSimFlags::JetpackActive, false);
+			}
+		}
+		TestTrue(TEXT("Depleted"), bDepleted);
+		TestEqual(TEXT("Drains once, then refuels once"), rateChanges, 2);
+	}
+
+	//A frame split into steps adds the same forces as one step over the frame.
+	{
+		FSymplMovementSimState state;
+		state.Set(ESymplMovementSimFlags::JetpackActive, true);
+		state.Set(ESymplMovementSimFlags::Sliding, true);
+		state.JetpackFuel = FSymplResourceMeter(config.MaxJetpackFuel, config.MaxJetpackFuel);
+		FSymplMovementSimInput input = SymplMovementTests::MakeInput(0.f);
+		input.Velocity = FVector::ForwardVector * config.RequiredSlideSpeed;
+		const FSymplMovementSimResult whole = SymplMovementSimulation::Step(config, state, input, 1.f / 60.f, queries);
+		const int32 steps = 4;
+		input.FrameFraction = 1.f / steps;
+		FVector jetpack = FVector::ZeroVector;
+		FVector slide = FVector::ZeroVector;
+		for (int32 i = 0; i < steps; i++)
+		{
+			const FSymplMovementSimResult split = SymplMovementSimulation::Step(config, state, input, 1.f / (60.f * steps), queries);
+			jetpack += split.JetpackPhysicsAcceleration;
+			slide += split.SlideForce;
+		}
+		TestTrue(TEXT("Split frame jetpack force"), jetpack.Equals(whole.JetpackPhysicsAcceleration, 1.e-3));
+		TestTrue(TEXT("Split frame slide force"), slide.Equals(whole.SlideForce, 1.e-6));
+		TestTrue(TEXT("Forces are applied"), !whole.JetpackPhysicsAcceleration.IsZero() && !whole.SlideForce.IsZero());
+	}
+
+	//Abilities run until their max time.
+	{
+		FSymplMovementSimState state;
+		state.Set(ESymplMovementSimFlags::Dashing, true);
+		state.DashStartTime = 0.f;
+		state.DashDirection = FVector::ForwardVector;
+		const FSymplMovementSimResult running = SymplMovementSimulation::Step(config, state, SymplMovementTests::MakeInput(config.MaxDashTime * .5f), 1.f / 60.f, queries);
+		TestTrue(TEXT("Dashing before MaxDashTime"), running.Has(ESymplMovementSimEvents::Dashing));
+		TestEqual(TEXT("Dash launch"), running.DashLaunch, FVector::ForwardVector * config.DashForce);
+		const FSymplMovementSimResult ended = SymplMovementSimulation::Step(config, state, SymplMovementTests::MakeInput(config.MaxDashTime + 1.f), 1.f / 60.f, queries);
+		TestTrue(TEXT("DashEnded after MaxDashTime"), ended.Has(ESymplMovementSimEvents::DashEnded));
+		TestFalse(TEXT("No launch after MaxDashTime"), ended.Has(ESymplMovementSimEvents::Dashing));
+	}
+
+	//Offsets for owners that aren't characters are OffsetMoveRate times a second.
+	{
+		FSymplMovementSimState state;
+		state.Set(ESymplMovementSimFlags::Rolling, true);
+		state.RollStartTime = 0.f;
+		state.RollDirection = FVector::ForwardVector;
+		state.Speed = 600.f;
+		FSymplMovementSimInput input = SymplMovementTests::MakeInput(0.f);
+		input.bIsCharacter = false;
+		const FSymplMovementSimResult fast = SymplMovementSimulation::Step(config, state, input, 1.f / 120.f, queries);
+		const FSymplMovementSimResult slow = SymplMovementSimulation::Step(config, state, input, 1.f / 30.f, queries);
+		TestEqual(TEXT("Roll offset scales with the step"), slow.RollInput.X, fast.RollInput.X * 4.f, 1.e-6);
+		const FSymplMovementSimResult frame = SymplMovementSimulation::Step(config, state, input, 1.f / 60.f, queries);
+		TestEqual(TEXT("Roll offset at 60 fps is the speed"), frame.RollInput.X, state.Speed, 1.e-6);
+	}
+
+	//The same state and input give the same result.
+	{
+		FSymplMovementSimState state;
+		state.MovementMode = EAdvancedMovementMode::EWALK;
+		state.Set(ESymplMovementSimFlags::JetpackActive, true);
+		state.JetpackFuel = FSymplResourceMeter(config.MaxJetpackFuel, config.MaxJetpackFuel);
+		FSymplMovementSimState a = state;
+		FSymplMovementSimState b = state;
+		for (int32 i = 0; i < 120; i++)
+		{
+			FSymplMovementSimInput input = SymplMovementTests::MakeInput(i / 60.f);
+			input.Velocity = a.Velocity;
+			a = SymplMovementSimulation::Step(config, a, input, 1.f / 60.f, queries).State;
+			input.Velocity = b.Velocity;
+			b = SymplMovementSimulation::Step(config, b, input, 1.f / 60.f, queries).State;
+		}
+		TestEqual(TEXT("Deterministic velocity"), a.Velocity, b.Velocity);
+		TestTrue(TEXT("Deterministic fuel"), a.JetpackFuel == b.JetpackFuel);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSymplResourceMeterTest, "SymplAdvancedMovement.Simulation.ResourceMeter", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSymplResourceMeterTest::RunTest(const FString& Parameters)
+{
+	FSymplResourceMeter meter(100.f, 100.f);
+	TestEqual(TEXT("Starts at the value"), meter.GetValue(5.f), 100.0);
+
+	meter.SetRate(10.f, -20.f);
+	TestEqual(TEXT("Unchanged at the event"), meter.GetValue(10.f), 100.0);
+	TestEqual(TEXT("Drains at the rate"), meter.GetValue(12.f), 60.0);
+	TestEqual(TEXT("Clamped at 0"), meter.GetValue(100.f), 0.0);
+	TestTrue(TEXT("Empty"), meter.IsEmpty(15.f));
+	TestEqual(TEXT("Time to empty"), meter.GetTimeToReach(10.f, 0.f), 15.0);
+	TestTrue(TEXT("Never refills while draining"), meter.GetTimeToReach(12.f, 100.f) < 0.f);
+
+	meter.SetRate(12.f, 10.f);
+	TestEqual(TEXT("Rebased at the rate change"), meter.GetValue(12.f), 60.0);
+	TestEqual(TEXT("Refills at the new rate"), meter.GetValue(14.f), 80.0);
+	TestEqual(TEXT("Clamped at MaxValue"), meter.GetValue(100.f), 100.0);
+
+	TestFalse(TEXT("Can't spend more than there is"), meter.Spend(12.f, 70.f));
+	TestEqual(TEXT("Failed spend changes nothing"), meter.GetValue(12.f), 60.0);
+	TestTrue(TEXT("Spend"), meter.Spend(12.f, 50.f));
+	TestEqual(TEXT("Spent"), meter.GetValue(12.f), 10.0);
+
+	meter.SetMaxValue(12.f, 5.f);
+	TestEqual(TEXT("Lowering MaxValue clamps the value"), meter.GetValue(12.f), 5.0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSymplMovementSnapshotTest, "SymplAdvancedMovement.Simulation.Snapshot", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSymplMovementSnapshotTest::RunTest(const FString& Parameters)
+{
+	FSymplMovementSnapshotState state;
+	state.RuntimeState.MovementStateFlags = (uint32)(ESymplMovementSimFlags::Dashing | ESymplMovementSimFlags::Sprinting);
+	state.RuntimeState.CurrentMovementMode = EAdvancedMovementMode::EDASH;
+	state.RuntimeState.bDidJump = true;
+	state.RuntimeState.CurrentVelocity = FVector(1.f, 2.f, 3.f);
+	state.RuntimeState.DashStartTime = 40.f;
+	state.RuntimeState.JetpackFuel = FSymplResourceMeter(50.f, 100.f);
+	state.RuntimeState.JetpackFuel.SetRate(40.f, -5.f);
+	state.ModeStack.Reset(EAdvancedMovementMode::EWALK);
+	state.ModeStack.Push(ESymplMovementState::Sprinting, EAdvancedMovementMode::ESPRINT);
+	state.ModeStack.Push(ESymplMovementState::Dashing, EAdvancedMovementMode::EDASH);
+	state.DashCharges = FSymplResourceMeter(1.f, 2.f);
+	state.LastCharacterMovementMode = MOVE_Walking;
+	state.LastMaxAcceleration = 2048.f;
+
+	FSymplMovementSnapshot snapshot;
+	snapshot.Write(state, 42.f);
+
+	FSymplMovementSnapshotState read;
+	double time = 0.f;
+	TestTrue(TEXT("Read"), snapshot.Read(read, time));
+	TestEqual(TEXT("Save time"), time, 42.0);
+	TestTrue(TEXT("Flags"), read.RuntimeState.MovementStateFlags == state.RuntimeState.MovementStateFlags);
+	TestTrue(TEXT("Mode"), read.RuntimeState.CurrentMovementMode == EAdvancedMovementMode::EDASH);
+	TestTrue(TEXT("Packed bool"), read.RuntimeState.bDidJump);
+	TestEqual(TEXT("Velocity"), read.RuntimeState.CurrentVelocity, state.RuntimeState.CurrentVelocity);
+	TestEqual(TEXT("Ability time"), read.RuntimeState.DashStartTime, 40.0);
+	TestTrue(TEXT("Fuel"), read.RuntimeState.JetpackFuel == state.RuntimeState.JetpackFuel);
+	TestEqual(TEXT("Mode stack size"), read.ModeStack.GetNum(), 2);
+	TestTrue(TEXT("Mode stack top"), read.ModeStack.GetMode() == EAdvancedMovementMode::EDASH);
+	TestTrue(TEXT("Mode stack base"), read.ModeStack.BaseMode == EAdvancedMovementMode::EWALK);
+	TestTrue(TEXT("Charges"), read.DashCharges == state.DashCharges);
+	TestTrue(TEXT("Character movement mode"), read.LastCharacterMovementMode == MOVE_Walking);
+	TestEqual(TEXT("Max acceleration"), read.LastMaxAcceleration, 2048.0);
+
+	//Restoring into another world moves every time but leaves stopped abilities stopped.
+	read.ShiftTime(100.f);
+	TestEqual(TEXT("Shifted ability time"), read.RuntimeState.DashStartTime, 140.0);
+	TestEqual(TEXT("Stopped ability stays stopped"), read.RuntimeState.RollStartTime, -1.0);
+	TestEqual(TEXT("Shifted meter"), read.RuntimeState.JetpackFuel.GetValue(142.f), state.RuntimeState.JetpackFuel.GetValue(42.f));
+
+	AddExpectedError(TEXT("version"), EAutomationExpectedErrorFlags::Contains, 1);
+	FSymplMovementSnapshot otherVersion = snapshot;
+	otherVersion.Data[0] = FSymplMovementSnapshot::Version + 1;
+	TestFalse(TEXT("Other versions are rejected"), otherVersion.Read(read, time));
+
+	AddExpectedError(TEXT("corrupt"), EAutomationExpectedErrorFlags::Contains, 1);
+	FSymplMovementSnapshot trailing = snapshot;
+	trailing.Data.Add(0);
+	TestFalse(TEXT("Snapshots with trailing data are rejected"), trailing.Read(read, time));
+
+	TestFalse(TEXT("Empty snapshots are rejected"), FSymplMovementSnapshot().Read(read, time));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSymplMovementReplayEncodingTest, "SymplAdvancedMovement.Simulation.ReplayEncoding", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSymplMovementReplayEncodingTest::RunTest(const FString& Parameters)
+{
+	//Zero runs longer than a count byte, single zeros between literals, literal runs longer than a count byte, and a trailing zero.
+	TArray<uint8> raw;
+	raw.AddZeroed(600);
+	raw.Append({ 1, 0, 2, 3, 0, 0, 4 });
+	for (int32 i = 0; i < 300; i++)
+	{
+		raw.Add((uint8)(i % 255 + 1));
+	}
+	raw.Add(0);
+
+	TArray<uint8> encoded;
+	SymplMovementReplay::Encode(raw.GetData(), raw.Num(), encoded);
+	TestTrue(TEXT("Zero runs are compressed"), encoded.Num() < raw.Num());
+
+	TArray<uint8> decoded;
+	decoded.SetNumUninitialized(raw.Num());
+	TestTrue(TEXT("Decode"), SymplMovementReplay::Decode(encoded.GetData(), encoded.Num(), decoded.GetData(), decoded.Num()));
+	TestTrue(TEXT("Round trip"), decoded == raw);
+
+	TArray<uint8> zeros;
+	zeros.AddZeroed(64);
+	TArray<uint8> encodedZeros;
+	SymplMovementReplay::Encode(zeros.GetData(), zeros.Num(), encodedZeros);
+	TestEqual(TEXT("All zeros is one pair"), encodedZeros.Num(), 2);
+
+	TArray<uint8> empty;
+	SymplMovementReplay::Encode(nullptr, 0, empty);
+	TestEqual(TEXT("Nothing to encode"), empty.Num(), 0);
+	TestTrue(TEXT("Nothing to decode"), SymplMovementReplay::Decode(nullptr, 0, nullptr, 0));
+
+	TestFalse(TEXT("Wrong raw size"), SymplMovementReplay::Decode(encoded.GetData(), encoded.Num(), decoded.GetData(), decoded.Num() - 1));
+	TestFalse(TEXT("Truncated"), SymplMovementReplay::Decode(encoded.GetData(), encoded.Num() - 1, decoded.GetData(), decoded.Num()));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSymplMovementStateContainersTest, "SymplAdvancedMovement.Simulation.StateContainers", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSymplMovementStateContainersTest::RunTest(const FString& Parameters)
+{
+	//Exiting a state falls back to the mode below it, wherever the state was in the stack.
+	FSymplMovementModeStack stack;
+	stack.Reset(EAdvancedMovementMode::EWALK);
+	stack.Push(ESymplMovementState::Sprinting, EAdvancedMovementMode::ESPRINT);
+	stack.Push(ESymplMovementState::Jetpack, EAdvancedMovementMode::EJETPACK);
+	TestFalse(TEXT("Removing a buried entry"), stack.Remove(ESymplMovementState::Sprinting));
+	TestTrue(TEXT("Top stays"), stack.GetMode() == EAdvancedMovementMode::EJETPACK);
+	TestTrue(TEXT("Removing the top entry"), stack.Remove(ESymplMovementState::Jetpack));
+	TestTrue(TEXT("Back to the base mode"), stack.GetMode() == EAdvancedMovementMode::EWALK);
+
+	//The rollback ring keeps the last Capacity frames.
+	FSymplMovementRollbackBuffer buffer;
+	buffer.Init(4);
+	for (int32 frame = 0; frame < 6; frame++)
+	{
+		buffer.Add(frame).Input.Time = frame;
+	}
+	TestNull(TEXT("Overwritten frame"), buffer.Find(1));
+	TestNotNull(TEXT("Oldest kept frame"), buffer.Find(2));
+	TestEqual(TEXT("Frame contents"), buffer.Find(5)->Input.Time, 5.0);
+	TestNull(TEXT("Future frame"), buffer.Find(6));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSymplMovementTuningTest, "SymplAdvancedMovement.Simulation.Tuning", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSymplMovementTuningTest::RunTest(const FString& Parameters)
+{
+	//Overrides of the old per frame properties land in the per second ones.
+	FSymplMovementTuning tuning;
+	TestTrue(TEXT("Old drain name"), FSymplMovementTuningOverride(TEXT("JetpackDrainRate"), 2.f).Apply(tuning));
+	TestEqual(TEXT("Drain per second"), tuning.JetpackDrainPerSecond, 120.0);
+	TestTrue(TEXT("Old refuel name"), FSymplMovementTuningOverride(TEXT("JetpackRefuelRate"), 1.f).Apply(tuning));
+	TestEqual(TEXT("Refuel per second"), tuning.JetpackRefuelPerSecond, 60.0);
+	TestTrue(TEXT("Old jetpack force name"), FSymplMovementTuningOverride(TEXT("JetpackForce"), 10000.f).Apply(tuning));
+	TestEqual(TEXT("Jetpack acceleration"), tuning.JetpackAcceleration, 600000.0);
+	TestTrue(TEXT("New names are unchanged"), FSymplMovementTuningOverride(TEXT("JetpackDrainPerSecond"), 45.f).Apply(tuning));
+	TestEqual(TEXT("Drain per second set directly"), tuning.JetpackDrainPerSecond, 45.0);
+	TestEqual(TEXT("Deprecated value stays unset"), tuning.JetpackDrainRate, -1.0);
+
+	//Old saved values are converted on load.
+	FSymplMovementTuning saved;
+	saved.JetpackDrainRate = 1.f;
+	saved.JetpackRefuelRate = .5f;
+	TArray<uint8> bytes;
+	FMemoryWriter writer(bytes);
+	FSymplMovementTuning::StaticStruct()->SerializeItem(writer, &saved, nullptr);
+	FSymplMovementTuning loaded;
+	FMemoryReader reader(bytes);
+	FSymplMovementTuning::StaticStruct()->SerializeItem(reader, &loaded, nullptr);
+	TestEqual(TEXT("Loaded drain per second"), loaded.JetpackDrainPerSecond, 60.0);
+	TestEqual(TEXT("Loaded refuel per second"), loaded.JetpackRefuelPerSecond, 30.0);
+	TestTrue(TEXT("Deprecated values are cleared"), loaded.JetpackDrainRate < 0.f && loaded.JetpackRefuelRate < 0.f);
+	return true;
+}
+
+#endif
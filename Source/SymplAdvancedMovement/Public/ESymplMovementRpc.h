@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * The rpcs of the advanced movement component.
+ * Used to look up rate limits, rejection counters and net stats.
+ */
+UENUM(BlueprintType,Blueprintable)
+enum class ESymplMovementRpc : uint8
+{
+	EUPDATETRANSFORM UMETA(DisplayName = "Update Transform", Tooltip = "Server_UpdateTransform."),
+	ESETJETPACKFUEL UMETA(DisplayName = "Set Jetpack Fuel", Tooltip = "Server_SetJetpackFuel."),
+	ESETZEROG UMETA(DisplayName = "Set Zero G", Tooltip = "Server_SetZeroGMovement."),
+	ESETJETPACK UMETA(DisplayName = "Set Jetpack", Tooltip = "Server_SetJetpack."),
+	ESETINPUT UMETA(DisplayName = "Set Input", Tooltip = "Server_SetForwardInput, Server_SetRightInput and Server_SetUpInput."),
+	EDEPLOYPARACHUTE UMETA(DisplayName = "Deploy Parachute", Tooltip = "Server_DeployParachute."),
+	ERELEASEPARACHUTE UMETA(DisplayName = "Release Parachute", Tooltip = "Server_ReleaseParachute."),
+	ESETPRONE UMETA(DisplayName = "Set Prone", Tooltip = "Server_SetProne."),
+	ESETHOVERING UMETA(DisplayName = "Set Hovering", Tooltip = "Server_SetHovering."),
+	ESETMOVEMENTMODE UMETA(DisplayName = "Set Movement Mode", Tooltip = "Server_SetMovementMode."),
+	ESETMOVEMENTSPEEDS UMETA(DisplayName = "Set Movement Speeds", Tooltip = "Server_SetMovementSpeeds."),
+	EDOCLIMB UMETA(DisplayName = "Do Climb", Tooltip = "Server_DoClimb."),
+	EADVANCEDJUMP UMETA(DisplayName = "Advanced Jump", Tooltip = "Server_AdvancedJump."),
+	ELANDED UMETA(DisplayName = "Landed", Tooltip = "Server_Landed."),
+	EINITIALIZE UMETA(DisplayName = "Initialize", Tooltip = "Server_Initialize."),
+	ESETAUTORUN UMETA(DisplayName = "Set Auto Run", Tooltip = "Server_SetAutoRunEnabled."),
+	ECLIMBCHECK UMETA(DisplayName = "Climb Check", Tooltip = "Server_FrontCheck_Climb, Server_LeftCheck_Climb and Server_RightCheck_Climb."),
+	EADVANCEDCROUCH UMETA(DisplayName = "Advanced Crouch", Tooltip = "Server_AdvancedCrouch."),
+	ESPRINT UMETA(DisplayName = "Sprint", Tooltip = "Server_Sprint."),
+	EDASH UMETA(DisplayName = "Dash", Tooltip = "Server_Dash."),
+	EBLINK UMETA(DisplayName = "Blink", Tooltip = "Server_Blink."),
+	EROLL UMETA(DisplayName = "Roll", Tooltip = "Server_Roll."),
+	EPLAYMONTAGE UMETA(DisplayName = "Play Montage", Tooltip = "Server_PlayMontage."),
+	EREWINDTRAJECTORY UMETA(DisplayName = "Rewind Trajectory", Tooltip = "Server_RewindTrajectory."),
+	EPLAYMONTAGEMULTICAST UMETA(DisplayName = "Play Montage Multicast", Tooltip = "Multicast_PlayMontage."),
+	ECLIENTJUMP UMETA(DisplayName = "Client Jump", Tooltip = "Client_Jump."),
+	ECLIENTCROUCH UMETA(DisplayName = "Client Crouch", Tooltip = "Client_Crouch."),
+	ECORRECTMOVEMENT UMETA(DisplayName = "Correct Movement", Tooltip = "Client_CorrectMovement."),
+	EMAX UMETA(Hidden)
+};
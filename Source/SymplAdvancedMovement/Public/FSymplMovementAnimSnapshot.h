@@ -0,0 +1,176 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "EAdvancedMovementMode.h"
+#include "EMovementAnimType.h"
+
+#include "FSymplMovementAnimSnapshot.generated.h"
+
+/**
+ * Immutable copy of the movement state that an anim bp needs.
+ * The component publishes one of these at the end of every tick so anim graphs can read it
+ * from NativeThreadSafeUpdateAnimation or thread safe anim bp functions without touching the component.
+ */
+USTRUCT(BlueprintType, Blueprintable)
+struct SYMPLADVANCEDMOVEMENT_API FSymplMovementAnimSnapshot
+{
+
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * The frame this snapshot was published on.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		int64 FrameNumber;
+
+	/**
+	 * The current movement mode.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		TEnumAsByte<EAdvancedMovementMode> MovementMode;
+
+	/**
+	 * The last movement mode.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		TEnumAsByte<EAdvancedMovementMode> LastMovementMode;
+
+	/**
+	 * The current movement anim type.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		TEnumAsByte<EMovementAnimType> MovementType;
+
+	/**
+	 * True if the owner is sliding.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		bool bSliding;
+
+	/**
+	 * True if the owner is crouching.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		bool bCrouching;
+
+	/**
+	 * True if the owner is sprinting.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		bool bSprinting;
+
+	/**
+	 * True if the owner is prone.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		bool bProne;
+
+	/**
+	 * True if the owner is dashing.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		bool bDashing;
+
+	/**
+	 * True if the owner is blinking.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		bool bBlinking;
+
+	/**
+	 * True if the owner is rolling.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		bool bRolling;
+
+	/**
+	 * True if the owner is hovering.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		bool bHovering;
+
+	/**
+	 * True if the owner did their first jump.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		bool bDidJump;
+
+	/**
+	 * True if the owner is parachuting.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		bool bIsParachuting;
+
+	/**
+	 * True if the owner is in zero g.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		bool bZeroGMovement;
+
+	/**
+	 * True if the owner's jetpack is active.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		bool bJetpackActive;
+
+	/**
+	 * True if the owner is auto running.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		bool bAutoRunEnabled;
+
+	/**
+	 * The owner's velocity.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		FVector Velocity;
+
+	/**
+	 * The angle of the slope the owner is standing on.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		double SlopeAngle;
+
+	/**
+	 * The current movement speed.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		double Speed;
+
+	/**
+	 * FVector(Forward,Right,Up) input.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		FVector InputDirection;
+
+	FSymplMovementAnimSnapshot()
+	{
+		FrameNumber = 0;
+		MovementMode = EAdvancedMovementMode::ENONE;
+		LastMovementMode = EAdvancedMovementMode::ENONE;
+		MovementType = EMovementAnimType::ENONE;
+		bSliding = false;
+		bCrouching = false;
+		bSprinting = false;
+		bProne = false;
+		bDashing = false;
+		bBlinking = false;
+		bRolling = false;
+		bHovering = false;
+		bDidJump = false;
+		bIsParachuting = false;
+		bZeroGMovement = false;
+		bJetpackActive = false;
+		bAutoRunEnabled = false;
+		Velocity = FVector::ZeroVector;
+		SlopeAngle = 0.f;
+		Speed = 0.f;
+		InputDirection = FVector::ZeroVector;
+	}
+
+};
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "FSymplRpcNetStats.h"
+#include "FSymplPropertyNetStats.h"
+
+#include "FSymplMovementNetStats.generated.h"
+
+/**
+ * Network statistics for a movement component. Collected on the server while Sympl.NetStats is 1.
+ */
+USTRUCT(BlueprintType, Blueprintable)
+struct SYMPLADVANCEDMOVEMENT_API FSymplMovementNetStats
+{
+
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Stats for every rpc that has been called.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		TArray<FSymplRpcNetStats> Rpcs;
+
+	/**
+	 * Stats for every replicated property.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		TArray<FSymplPropertyNetStats> Properties;
+
+	/**
+	 * Rpc parameter struct bytes in the last second. See FSymplRpcNetStats::Bytes.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		float RpcBytesPerSecond;
+
+	/**
+	 * Property bytes in the last second.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		float PropertyBytesPerSecond;
+
+	FSymplMovementNetStats()
+	{
+		RpcBytesPerSecond = 0.f;
+		PropertyBytesPerSecond = 0.f;
+	}
+
+};
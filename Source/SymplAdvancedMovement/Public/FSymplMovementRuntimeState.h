@@ -0,0 +1,156 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "EAdvancedMovementMode.h"
+#include "EMovementAnimType.h"
+#include "FSymplResourceMeter.h"
+
+#include "FSymplMovementRuntimeState.generated.h"
+
+/**
+ * The movement component's per frame runtime state, kept together so the tick reads contiguous memory instead of fields spread between designer settings.
+ * Ordered by how often the tick touches them: the fields read every frame fit in the first cache line,
+ * ability timers and meters follow, and ability directions that are only read while an ability is active come last.
+ */
+USTRUCT(BlueprintType)
+struct SYMPLADVANCEDMOVEMENT_API FSymplMovementRuntimeState
+{
+
+	GENERATED_BODY()
+
+public:
+
+	//The active movement states as ESymplMovementSimFlags. Only changed through the state machine.
+	UPROPERTY()
+		uint32 MovementStateFlags;
+
+	//The movement mode for adjusting speed.
+	UPROPERTY()
+		TEnumAsByte<EAdvancedMovementMode> CurrentMovementMode;
+
+	//The last movement mode for adjusting speed.
+	UPROPERTY()
+		TEnumAsByte<EAdvancedMovementMode> LastMovementMode;
+
+	//The movement anim type for animations.
+	UPROPERTY()
+		TEnumAsByte<EMovementAnimType> CurrentMovementType;
+
+	//Determines if the player did their first jump.
+	UPROPERTY()
+		bool bDidJump;
+
+	//Determines if the player is autorunning.
+	UPROPERTY()
+		bool bAutoRunEnabled;
+
+	//Determines if the player has initialized the component.
+	UPROPERTY()
+		bool bInitialized;
+
+	//The number of times the player has double jumped.
+	UPROPERTY()
+		int32 DoubleJumpCounter;
+
+	//The current movement speed.
+	UPROPERTY()
+		double CurrentSpeed;
+
+	//The angle of our walking slope.
+	UPROPERTY()
+		double CurrentSlopeAngle;
+
+	//The speed scalar for slope angle.
+	UPROPERTY()
+		double CurrentSlopeSpeedScalar;
+
+	//The current velocity of our player.
+	UPROPERTY()
+		FVector CurrentVelocity;
+
+	//Forward movement input.
+	UPROPERTY()
+		double ForwardInput;
+
+	//Right movement input.
+	UPROPERTY()
+		double RightInput;
+
+	//Up movement input.
+	UPROPERTY()
+		double UpInput;
+
+	//Server world time each ability started at. Negative when the ability isn't running.
+	UPROPERTY()
+		double ClimbStartTime;
+
+	UPROPERTY()
+		double RollStartTime;
+
+	UPROPERTY()
+		double DashStartTime;
+
+	UPROPERTY()
+		double BlinkStartTime;
+
+	UPROPERTY()
+		double SlideStartTime;
+
+	UPROPERTY()
+		double HoverStartTime;
+
+	//Jetpack fuel. Only changes when it starts or stops draining or refueling.
+	UPROPERTY()
+		FSymplResourceMeter JetpackFuel;
+
+	//Sprint stamina. Only changes when it starts or stops draining or regenerating.
+	UPROPERTY()
+		FSymplResourceMeter SprintStamina;
+
+	//The current dash direction.
+	UPROPERTY()
+		FVector CurrentDashDirection;
+
+	//The current blink direction.
+	UPROPERTY()
+		FVector CurrentBlinkDirection;
+
+	//The current roll direction.
+	UPROPERTY()
+		FVector CurrentRollDirection;
+
+	FSymplMovementRuntimeState()
+	{
+		MovementStateFlags = 0;
+		CurrentMovementMode = EAdvancedMovementMode::ENONE;
+		LastMovementMode = EAdvancedMovementMode::ENONE;
+		CurrentMovementType = EMovementAnimType::ENONE;
+		bDidJump = false;
+		bAutoRunEnabled = false;
+		bInitialized = false;
+		DoubleJumpCounter = 0;
+		CurrentSpeed = 0.f;
+		CurrentSlopeAngle = 0.f;
+		CurrentSlopeSpeedScalar = 1.f;
+		CurrentVelocity = FVector::ZeroVector;
+		ForwardInput = 0.f;
+		RightInput = 0.f;
+		UpInput = 0.f;
+		ClimbStartTime = -1.f;
+		RollStartTime = -1.f;
+		DashStartTime = -1.f;
+		BlinkStartTime = -1.f;
+		SlideStartTime = -1.f;
+		HoverStartTime = -1.f;
+		CurrentDashDirection = FVector::ZeroVector;
+		CurrentBlinkDirection = FVector::ZeroVector;
+		CurrentRollDirection = FVector::ZeroVector;
+	}
+
+	//Compact binary form for snapshots. Bools are packed into one byte.
+	friend SYMPLADVANCEDMOVEMENT_API FArchive& operator<<(FArchive& Ar, FSymplMovementRuntimeState& State);
+
+};
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+#include "FSymplMovementRuntimeState.h"
+#include "FSymplResourceMeter.h"
+#include "SymplMovementModeStack.h"
+
+#include "FSymplMovementSnapshot.generated.h"
+
+/**
+ * Everything needed to put a movement component back into an earlier state.
+ * Fixed size with no heap memory, so it can be copied around freely.
+ */
+struct SYMPLADVANCEDMOVEMENT_API FSymplMovementSnapshotState
+{
+	//Modes, flags, timers, meters, inputs and ability directions. The parachute is the Parachuting flag.
+	FSymplMovementRuntimeState RuntimeState;
+
+	//Modes pushed by the active movement states.
+	FSymplMovementModeStack ModeStack;
+
+	FSymplResourceMeter DashCharges;
+	FSymplResourceMeter BlinkCharges;
+	FSymplResourceMeter RollCharges;
+
+	//Character movement values to go back to when a state ends.
+	TEnumAsByte<EMovementMode> LastCharacterMovementMode = MOVE_None;
+	double LastBrakingFriction = 0.f;
+	double LastMaxAcceleration = 0.f;
+
+	//Move every server world time in the state by Delta, for restoring into a world with another clock.
+	void ShiftTime(double Delta);
+
+	friend SYMPLADVANCEDMOVEMENT_API FArchive& operator<<(FArchive& Ar, FSymplMovementSnapshotState& State);
+};
+
+/**
+ * A movement snapshot as a small versioned binary blob, for respawns, server migration and checkpoints.
+ * Reuse the same snapshot to save every frame, the buffer is sized once and never grows after that.
+ */
+USTRUCT(BlueprintType)
+struct SYMPLADVANCEDMOVEMENT_API FSymplMovementSnapshot
+{
+
+	GENERATED_BODY()
+
+public:
+
+	//Bump when the layout changes. Snapshots with another version are rejected.
+	static constexpr uint8 Version = 2;
+
+	//Larger than the largest snapshot.
+	static constexpr int32 MaxSize = 512;
+
+	UPROPERTY()
+		TArray<uint8> Data;
+
+	//Replace the blob with State, saved at server world time Time.
+	void Write(const FSymplMovementSnapshotState& State, double Time);
+
+	/**
+	 * Read the blob into State and the server world time it was saved at into OutTime.
+	 * The times in State are still on the saving world's clock, see FSymplMovementSnapshotState::ShiftTime.
+	 * Returns false and leaves State unusable if the blob is empty, from another version or corrupt.
+	*/
+	bool Read(FSymplMovementSnapshotState& State, double& OutTime) const;
+
+	bool IsEmpty() const { return Data.Num() == 0; }
+
+};
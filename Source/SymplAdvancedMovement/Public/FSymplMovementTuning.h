@@ -0,0 +1,365 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "FSymplMovementTuning.generated.h"
+
+/**
+ * Numeric tuning for the advanced movement component.
+ * Held by USymplMovementConfig so every component that uses the same asset shares one copy.
+ */
+USTRUCT(BlueprintType)
+struct SYMPLADVANCEDMOVEMENT_API FSymplMovementTuning
+{
+
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * The number of times the player can double jump before landing.
+	 * This value starts from 0 so a value of 0 = 1 double jump.
+	 * To disable double jumping set bAllowDoubleJump to false.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Jumping")
+		int32 AllowedNumberOfDoubleJumps;
+
+	/**
+	 * The radius for the sphere sweep that checks for a wall.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
+		double WallDetectTraceRadius;
+
+	/**
+	 * The radius for the sphere sweep that checks for a wall.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
+		double RequiredSlideAngle;
+
+	/**
+	 * The maximum amount of time a player can be wall running or climbing before the system resets.
+	 * Set this to a value <= 0 to make it infinite.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
+		double MaxJetpackFuel;
+
+	/**
+	 * The upward acceleration of the jetpack in cm/s^2. 600000 matches the old per frame JetpackForce of 10000 at 60 fps.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
+		double JetpackAcceleration;
+
+	//The old per frame jetpack force. Negative unless it was loaded from old data, PostSerialize converts it to JetpackAcceleration.
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use JetpackAcceleration, it is per second."))
+		double JetpackForce;
+
+	/**
+	 * The amount of fuel that the jetpack needs to activate.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
+		double RequiredFuelForJetpack;
+
+	/**
+	 * The amount of fuel the jetpack drains per second. 60 matches the old per frame JetpackDrainRate of 1 at 60 fps.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
+		double JetpackDrainPerSecond;
+
+	//The old per frame drain. Negative unless it was loaded from old data, PostSerialize converts it to JetpackDrainPerSecond.
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use JetpackDrainPerSecond."))
+		double JetpackDrainRate;
+
+	/**
+	 * The amount of fuel the jetpack refuels per second. 30 matches the old per frame JetpackRefuelRate of .5 at 60 fps.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
+		double JetpackRefuelPerSecond;
+
+	//The old per frame refuel. Negative unless it was loaded from old data, PostSerialize converts it to JetpackRefuelPerSecond.
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Use JetpackRefuelPerSecond."))
+		double JetpackRefuelRate;
+
+	/**
+	 * The maximum amount of time a player can be wall running or climbing before the system resets.
+	 * Set this to a value <= 0 to make it infinite.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
+		double MaxWallRun_ClimbTime;
+
+	/**
+	 * The maximum amount of time a player can be blinking
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Blink")
+		double MaxBlinkTime;
+
+	/**
+	 * The number of blink charges that can be stored.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Blink", meta = (ClampMin = "1"))
+		int32 MaxBlinkCharges;
+
+	/**
+	 * Seconds to regain one blink charge.
+	 * Set this to a value <= 0 to disable blink charges.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Blink", meta = (ClampMin = "0"))
+		double BlinkChargeCooldown;
+
+	/**
+	 * The value that we set a character's braking friction when sliding.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Crouching/Sliding")
+		double SlideBrakingFriction;
+
+	/**
+	 * The maximum amount of time a player can be dashing
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Dash")
+		double MaxDashTime;
+
+	/**
+	 * The number of dash charges that can be stored.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Dash", meta = (ClampMin = "1"))
+		int32 MaxDashCharges;
+
+	/**
+	 * Seconds to regain one dash charge.
+	 * Set this to a value <= 0 to disable dash charges.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Dash", meta = (ClampMin = "0"))
+		double DashChargeCooldown;
+
+	/**
+	 * The maximum amount of time a player can be hovering
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Hover")
+		double MaxHoverTime;
+
+	/**
+	 * The maximum amount of time a player can be rolling
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Roll")
+		double MaxRollTime;
+
+	/**
+	 * The number of roll charges that can be stored.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Roll", meta = (ClampMin = "1"))
+		int32 MaxRollCharges;
+
+	/**
+	 * Seconds to regain one roll charge.
+	 * Set this to a value <= 0 to disable roll charges.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Roll", meta = (ClampMin = "0"))
+		double RollChargeCooldown;
+
+	/**
+	 * The maximum amount of time a player can be sliding before the system resets.
+	 * Set this to a value <= 0 to make it infinite.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Crouching/Sliding")
+		double MaxSlideTime;
+
+	/**
+	 * The force to add to the slide. Owners that aren't characters slide SlideForce * OffsetMoveRate cm per second.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Crouching/Sliding")
+		double SlideForce;
+
+	/**
+	 * The force to add to the slide.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Sprinting")
+		double SprintSpeed;
+
+	/**
+	 * If true, sprinting drains stamina and ends when it runs out.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Sprinting")
+		bool bUseSprintStamina;
+
+	/**
+	 * The maximum sprint stamina.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Sprinting", meta = (ClampMin = "0"))
+		double MaxSprintStamina;
+
+	/**
+	 * The amount of stamina sprinting drains per second.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Sprinting", meta = (ClampMin = "0"))
+		double SprintStaminaDrainRate;
+
+	/**
+	 * The amount of stamina that regenerates per second while not sprinting.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Sprinting", meta = (ClampMin = "0"))
+		double SprintStaminaRegenRate;
+
+	/**
+	 * Used to scale the launch velocity when we finish wall run checks.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
+		double WallRun_ClimbLaunchVelocityScalar;
+
+	/**
+	 * The owner's velocity that is needed to be considered valid for sliding.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Crouching/Sliding")
+		double RequiredSlideSpeed;
+
+	/**
+	 * The owner's max acceleration when parachuting.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Parachute")
+		double ParachuteMaxAcceleration;
+
+	/**
+	 * The owner's distance to the nearest floor that is needed to deploy the parachute.
+	 * This is called separately in CanDeployParachute.
+	 * By default CanDelpoyParachute is not implemented in this component.
+	 * I have decided to separate it so you can implement it yourself since I see a lot of use cases where you will want to do it in other ways.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Parachute")
+		double RequiredDistanceToDeployParachute;
+
+	/**
+	 * The distance we trace from our owner location to find the floor.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Movement")
+		double FloorCheckDistance;
+
+	/**
+	 * How many times a second owners that aren't characters move by SlideForce, or by their speed when dashing, blinking, rolling or auto running.
+	 * They used to move by those once per frame, 60 keeps the distances they were tuned with at 60 fps.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Movement", meta = (ClampMin = "0"))
+		double OffsetMoveRate;
+
+	/**
+	 * The force we add to our blink velocity.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Blink")
+		double BlinkForce;
+
+	/**
+	 * The force we scale to our dash velocity.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Dash")
+		double DashForce;
+
+	/**
+	 * The force we add to our roll velocity.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Dash")
+		double RollForce;
+
+	FSymplMovementTuning()
+	{
+		AllowedNumberOfDoubleJumps = 0;
+		WallDetectTraceRadius = 15.f;
+		RequiredSlideAngle = 30.f;
+		MaxJetpackFuel = 100.f;
+		JetpackAcceleration = 600000.f;
+		JetpackForce = -1.f;
+		RequiredFuelForJetpack = .1f;
+		JetpackDrainPerSecond = 60.f;
+		JetpackDrainRate = -1.f;
+		JetpackRefuelPerSecond = 30.f;
+		JetpackRefuelRate = -1.f;
+		MaxWallRun_ClimbTime = 10.f;
+		MaxBlinkTime = 3.f;
+		MaxBlinkCharges = 1;
+		BlinkChargeCooldown = 0.f;
+		SlideBrakingFriction = 0.f;
+		MaxDashTime = 3.f;
+		MaxDashCharges = 1;
+		DashChargeCooldown = 0.f;
+		MaxHoverTime = 10.f;
+		MaxRollTime = 1.f;
+		MaxRollCharges = 1;
+		RollChargeCooldown = 0.f;
+		MaxSlideTime = 10.f;
+		SlideForce = 600.f;
+		SprintSpeed = 800.f;
+		bUseSprintStamina = false;
+		MaxSprintStamina = 100.f;
+		SprintStaminaDrainRate = 20.f;
+		SprintStaminaRegenRate = 10.f;
+		WallRun_ClimbLaunchVelocityScalar = 600.f;
+		RequiredSlideSpeed = 800.f;
+		ParachuteMaxAcceleration = 2500.f;
+		RequiredDistanceToDeployParachute = 10000.f;
+		FloorCheckDistance = 100000.f;
+		OffsetMoveRate = 60.f;
+		BlinkForce = 1500.f;
+		DashForce = 1500.f;
+		RollForce = 500.f;
+	}
+
+	//JetpackForce, JetpackDrainRate and JetpackRefuelRate were tuned per frame at 60 fps.
+	static constexpr double PerFrameToPerSecond = 60.f;
+
+	//The per second property that replaced a per frame one, or NAME_None if PerFrameName wasn't replaced.
+	static FName GetPerSecondName(FName PerFrameName);
+
+	//Convert per frame values saved before their per second properties existed.
+	void PostSerialize(const FArchive& Ar);
+
+};
+
+template<>
+struct TStructOpsTypeTraits<FSymplMovementTuning> : public TStructOpsTypeTraitsBase2<FSymplMovementTuning>
+{
+	enum
+	{
+		WithPostSerialize = true
+	};
+};
+
+/**
+ * A per instance change to one FSymplMovementTuning property.
+ */
+USTRUCT(BlueprintType)
+struct SYMPLADVANCEDMOVEMENT_API FSymplMovementTuningOverride
+{
+
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * The FSymplMovementTuning property to change.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Config", meta = (GetOptions = "SymplAdvancedMovement.SymplMovementConfig.GetTuningPropertyNames"))
+		FName Property;
+
+	/**
+	 * The new value. Integers are rounded and bools are true for any value other than 0.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Config")
+		double Value;
+
+	FSymplMovementTuningOverride()
+	{
+		Property = NAME_None;
+		Value = 0.f;
+	}
+
+	FSymplMovementTuningOverride(FName InProperty, double InValue)
+	{
+		Property = InProperty;
+		Value = InValue;
+	}
+
+	/**
+	 * Write Value into the matching property of Tuning. Returns false if there is no numeric or bool property with that name.
+	 * The per frame JetpackForce, JetpackDrainRate and JetpackRefuelRate are still accepted in their old units and written to their per second properties.
+	*/
+	bool Apply(FSymplMovementTuning& Tuning) const;
+
+};
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "FSymplPropertyNetStats.generated.h"
+
+/**
+ * Network statistics for one replicated property of a movement component.
+ * Changes are counted when the server replicates the component.
+ */
+USTRUCT(BlueprintType, Blueprintable)
+struct SYMPLADVANCEDMOVEMENT_API FSymplPropertyNetStats
+{
+
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * The property name.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		FName Property;
+
+	/**
+	 * Total changes.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		int32 Changes;
+
+	/**
+	 * Changes in the last second.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		float ChangesPerSecond;
+
+	/**
+	 * Total bytes. This is the unpacked size, so it is an upper bound of what goes on the wire.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		int64 Bytes;
+
+	/**
+	 * Bytes in the last second.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		float BytesPerSecond;
+
+	FSymplPropertyNetStats()
+	{
+		Property = NAME_None;
+		Changes = 0;
+		ChangesPerSecond = 0.f;
+		Bytes = 0;
+		BytesPerSecond = 0.f;
+	}
+
+};
@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "FSymplResourceMeter.generated.h"
+
+/**
+ * A resource (fuel, stamina, charges) that changes at a constant rate between events.
+ * The value is evaluated in closed form from the last event, so nothing has to run or replicate every frame.
+ * The fields only change when the rate or value is changed, which is all that needs to replicate.
+ */
+USTRUCT(BlueprintType, Blueprintable)
+struct SYMPLADVANCEDMOVEMENT_API FSymplResourceMeter
+{
+
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * The value at BaseTime.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		double BaseValue;
+
+	/**
+	 * Change per second since BaseTime. Negative drains.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		double Rate;
+
+	/**
+	 * Server world time of the last event.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		double BaseTime;
+
+	/**
+	 * The highest value.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		double MaxValue;
+
+	FSymplResourceMeter()
+	{
+		BaseValue = 0.f;
+		Rate = 0.f;
+		BaseTime = 0.f;
+		MaxValue = 0.f;
+	}
+
+	FSymplResourceMeter(double InValue, double InMaxValue)
+	{
+		MaxValue = FMath::Max(InMaxValue, 0.0);
+		BaseValue = FMath::Clamp(InValue, 0.0, MaxValue);
+		Rate = 0.f;
+		BaseTime = 0.f;
+	}
+
+	//The value at Time.
+	double GetValue(double Time) const { return FMath::Clamp(BaseValue + Rate * FMath::Max(Time - BaseTime, 0.0), 0.0, MaxValue); }
+
+	bool IsEmpty(double Time) const { return GetValue(Time) <= 0.f; }
+	bool IsFull(double Time) const { return GetValue(Time) >= MaxValue; }
+
+	//Change the rate from Time on.
+	void SetRate(double Time, double InRate)
+	{
+		Rebase(Time);
+		Rate = InRate;
+	}
+
+	//Set the value at Time, keeping the rate.
+	void SetValue(double Time, double Value)
+	{
+		BaseValue = FMath::Clamp(Value, 0.0, MaxValue);
+		BaseTime = Time;
+	}
+
+	//Change the max value at Time, keeping the current value if it still fits.
+	void SetMaxValue(double Time, double InMaxValue)
+	{
+		Rebase(Time);
+		MaxValue = FMath::Max(InMaxValue, 0.0);
+		BaseValue = FMath::Min(BaseValue, MaxValue);
+	}
+
+	//Add Amount at Time. Negative amounts remove.
+	void Add(double Time, double Amount) { SetValue(Time, GetValue(Time) + Amount); }
+
+	//Remove Amount at Time if there is enough. Returns false and changes nothing if there isn't.
+	bool Spend(double Time, double Amount)
+	{
+		const double value = GetValue(Time);
+		if (value < Amount)
+		{
+			return false;
+		}
+		SetValue(Time, value - Amount);
+		return true;
+	}
+
+	//The server world time the meter reaches Value at the current rate. Returns a negative number if it never will.
+	double GetTimeToReach(double Time, double Value) const
+	{
+		const double value = GetValue(Time);
+		if (value == Value)
+		{
+			return Time;
+		}
+		if (Rate == 0.f || (Value > value) != (Rate > 0.f) || Value < 0.f || Value > MaxValue)
+		{
+			return -1.f;
+		}
+		return Time + (Value - value) / Rate;
+	}
+
+	bool operator==(const FSymplResourceMeter& Other) const
+	{
+		return BaseValue == Other.BaseValue && Rate == Other.Rate && BaseTime == Other.BaseTime && MaxValue == Other.MaxValue;
+	}
+
+	bool operator!=(const FSymplResourceMeter& Other) const { return !(*this == Other); }
+
+	friend FArchive& operator<<(FArchive& Ar, FSymplResourceMeter& Meter)
+	{
+		return Ar << Meter.BaseValue << Meter.Rate << Meter.BaseTime << Meter.MaxValue;
+	}
+
+private:
+
+	//Fold the change since BaseTime into BaseValue.
+	void Rebase(double Time)
+	{
+		BaseValue = GetValue(Time);
+		BaseTime = Time;
+	}
+
+};
@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "ESymplMovementRpc.h"
+
+#include "FSymplRpcNetStats.generated.h"
+
+/**
+ * Network statistics for one rpc of a movement component.
+ * Server rpcs are counted when the server receives them, client and multicast rpcs when the server sends them.
+ */
+USTRUCT(BlueprintType, Blueprintable)
+struct SYMPLADVANCEDMOVEMENT_API FSymplRpcNetStats
+{
+
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * The rpc.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		ESymplMovementRpc Rpc;
+
+	/**
+	 * True if the rpc is reliable.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		bool bReliable;
+
+	/**
+	 * Total calls.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		int32 Calls;
+
+	/**
+	 * Calls in the last second.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		float CallsPerSecond;
+
+	/**
+	 * Total parameter struct bytes (UFunction::ParmsSize) of the calls.
+	 * This is not the wire size. Packed fields are smaller on the wire, and array or string parameters only count their inline header.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		int64 Bytes;
+
+	/**
+	 * Parameter bytes in the last second.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		float BytesPerSecond;
+
+	/**
+	 * The fullest the owner's reliable buffer (0-1) got when this rpc was sent in the last second.
+	*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		float ReliableBufferPressure;
+
+	FSymplRpcNetStats()
+	{
+		Rpc = ESymplMovementRpc::EMAX;
+		bReliable = false;
+		Calls = 0;
+		CallsPerSecond = 0.f;
+		Bytes = 0;
+		BytesPerSecond = 0.f;
+		ReliableBufferPressure = 0.f;
+	}
+
+};
@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "FSymplRpcRateLimit.generated.h"
+
+/**
+ * Token bucket settings for a server rpc.
+ */
+USTRUCT(BlueprintType, Blueprintable)
+struct SYMPLADVANCEDMOVEMENT_API FSymplRpcRateLimit
+{
+
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * The number of calls per second the bucket refills.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+		float CallsPerSecond;
+
+	/**
+	 * The maximum number of calls that can be made in a burst.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1"))
+		float Burst;
+
+	FSymplRpcRateLimit()
+	{
+		CallsPerSecond = 30.f;
+		Burst = 10.f;
+	}
+
+	FSymplRpcRateLimit(float InCallsPerSecond, float InBurst)
+	{
+		CallsPerSecond = InCallsPerSecond;
+		Burst = InBurst;
+	}
+
+};
@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "EAdvancedMovementMode.h"
+
+#include "FSymplTrajectorySample.generated.h"
+
+/**
+ * A single timestamped point in the owner's trajectory history.
+ */
+USTRUCT(BlueprintType, Blueprintable)
+struct SYMPLADVANCEDMOVEMENT_API FSymplTrajectorySample
+{
+
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * The server world time this sample was recorded at.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+		double Time;
+
+	/**
+	 * The owner's location.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+		FVector Location;
+
+	/**
+	 * The owner's velocity.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+		FVector Velocity;
+
+	/**
+	 * The movement mode at the time of the sample.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+		TEnumAsByte<EAdvancedMovementMode> MovementMode;
+
+	/**
+	 * True if the owner was on the ground.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+		bool bGrounded;
+
+	FSymplTrajectorySample()
+	{
+		Time = 0.f;
+		Location = FVector::ZeroVector;
+		Velocity = FVector::ZeroVector;
+		MovementMode = EAdvancedMovementMode::ENONE;
+		bGrounded = false;
+	}
+
+	FSymplTrajectorySample(double InTime, FVector InLocation, FVector InVelocity, TEnumAsByte<EAdvancedMovementMode> InMovementMode, bool InGrounded)
+	{
+		Time = InTime;
+		Location = InLocation;
+		Velocity = InVelocity;
+		MovementMode = InMovementMode;
+		bGrounded = InGrounded;
+	}
+
+};
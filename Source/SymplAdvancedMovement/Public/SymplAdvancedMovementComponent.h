@@ -7,6 +7,7 @@
 #include "Gameframework/Character.h"
 #include "Gameframework/Pawn.h"
 #include "Engine/DataTable.h"
+#include "Engine/StreamableManager.h"
 
 #include "EMovementAnimType.h"
 #include "EAdvancedMovementMode.h"
@@ -15,6 +16,24 @@
 #include "FSymplMovementAnimations.h"
 #include "FSymplMovementAnimation.h"
 #include "FSymplMovementModeAnimation.h"
+#include "FSymplMovementAnimSnapshot.h"
+#include "FSymplTrajectorySample.h"
+#include "SymplTrajectoryHistory.h"
+#include "SymplRpcRateLimiter.h"
+#include "SymplNetStatsTracker.h"
+#include "FSymplMovementNetStats.h"
+#include "FSymplResourceMeter.h"
+#include "FSymplMovementRuntimeState.h"
+#include "FSymplMovementTuning.h"
+#include "SymplMovementConfig.h"
+#include "FSymplMovementSnapshot.h"
+#include "SymplMovementReplay.h"
+#include "SymplMovementRollback.h"
+#include "SymplMovementSimulation.h"
+#include "SymplMovementStateMachine.h"
+#include "SymplMovementModeStack.h"
+
+#include <atomic>
 
 #include "SymplAdvancedMovementComponent.generated.h"
 
@@ -27,6 +46,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDidSprint, USymplAdvancedMovementCo
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSelectedSpeedsUpdate, USymplAdvancedMovementComponent*, Component);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCurrentSpeedUpdate, USymplAdvancedMovementComponent*, Component);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FMovementModeUpdate, USymplAdvancedMovementComponent*, Component);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FMovementModeTransition, USymplAdvancedMovementComponent*, Component, EAdvancedMovementMode, FromMode, EAdvancedMovementMode, ToMode);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDidProne, USymplAdvancedMovementComponent*, Component);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDidHover, USymplAdvancedMovementComponent*, Component);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDidDash, USymplAdvancedMovementComponent*, Component);
@@ -36,6 +56,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDidParachute, USymplAdvancedMovemen
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDidZeroG, USymplAdvancedMovementComponent*, Component);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDidJetpack, USymplAdvancedMovementComponent*, Component);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FJetpackFuelUpdate, USymplAdvancedMovementComponent*, Component);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSprintStaminaUpdate, USymplAdvancedMovementComponent*, Component);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAnimationUpdate, USymplAdvancedMovementComponent*, Component);
 
 /**
@@ -66,7 +87,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAnimationUpdate, USymplAdvancedMove
  *  Make sure to implement the Server_Landed function to reset values.
 */
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent), BlueprintType,Blueprintable )
-class SYMPLADVANCEDMOVEMENT_API USymplAdvancedMovementComponent : public UActorComponent
+class SYMPLADVANCEDMOVEMENT_API USymplAdvancedMovementComponent : public UActorComponent, public ISymplMovementSimQueries
 {
 	GENERATED_BODY()
 
@@ -130,6 +151,13 @@ public:
 	UPROPERTY(BlueprintCallable, BlueprintAssignable, Category = "AdvancedMovement")
 		FMovementModeUpdate MovementModeUpdate;
 
+	/**
+	 * Notify that our movement mode changed this frame.
+	 * Mode changes are staged and committed once at the end of the tick, so this fires at most once per frame.
+	*/
+	UPROPERTY(BlueprintCallable, BlueprintAssignable, Category = "AdvancedMovement")
+		FMovementModeTransition MovementModeTransition;
+
 	/**
 	 * Notify that we switched prone state.
 	*/
@@ -179,11 +207,17 @@ public:
 		FDidJetpack DidJetpack;
 
 	/**
-	 * Notify that we toggled our jetpack.
+	 * Notify that our jetpack fuel started or stopped draining or refueling, or was set.
 	*/
 	UPROPERTY(BlueprintCallable, BlueprintAssignable, Category = "AdvancedMovement")
 		FJetpackFuelUpdate JetpackFuelUpdate;
 
+	/**
+	 * Notify that our sprint stamina started or stopped draining or regenerating.
+	*/
+	UPROPERTY(BlueprintCallable, BlueprintAssignable, Category = "AdvancedMovement")
+		FSprintStaminaUpdate SprintStaminaUpdate;
+
 	/**
 	 * Notify that we have updated animations.
 	*/
@@ -225,6 +259,15 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Movement")
 		FDataTableRowHandle AnimationRow;
 
+	/**
+	 * If true, every animation referenced by the animation row, and everything they reference, is requested through the
+	 * streamable manager when the component initializes and kept resident for the component's lifetime.
+	 * This moves the first use load of dash, roll, double jump and parachute montages (and their notify assets) to init time
+	 * when the animation table is streamed in. Animations that are already resident cost nothing.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Animations")
+		bool bWarmUpAnimations;
+
 	/**
 	 * The channel we use to trace for wall collisions.
 	*/
@@ -250,7 +293,7 @@ public:
 		TEnumAsByte<EAdvancedMovementMode> DefaultMovementMode;
 
 	/**
-	 * If true, the player will restore jetpack fuel when bJetpackActive == false.
+	 * If true, the player will restore jetpack fuel when the jetpack isn't active.
 	*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Jumping")
 		bool bRestoreJetpackFuelWhenInactive;
@@ -398,216 +441,262 @@ public:
 		bool bForceCustomCrouch;
 
 	/**
-	 * The number of times the player can double jump before landing.
-	 * This value starts from 0 so a value of 0 = 1 double jump.
-	 * To disable double jumping set bAllowDoubleJump to false.
+	 * Shared tuning. Components that use the same asset and have no overrides share one copy of the tuning.
+	 * If this is not set the defaults of USymplMovementConfig are used.
+	 * Replicated, so the server and clients simulate with the same tuning.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Jumping")
-		int32 AllowedNumberOfDoubleJumps;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, ReplicatedUsing = OnRep_MovementConfig, Category = "AdvancedMovement|Config")
+		USymplMovementConfig* MovementConfig;
 
 	/**
-	 * The radius for the sphere sweep that checks for a wall.
+	 * Per instance changes on top of MovementConfig.
+	 * Only components with overrides keep their own copy of the tuning. Replicated like MovementConfig.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
-		double WallDetectTraceRadius;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, ReplicatedUsing = OnRep_MovementConfig, Category = "AdvancedMovement|Config")
+		TArray<FSymplMovementTuningOverride> TuningOverrides;
 
 	/**
-	 * The radius for the sphere sweep that checks for a wall.
+	 * The socket we attach the parachute actor to.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
-		double RequiredSlideAngle;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Parachute")
+		FName ParachuteAttachSocket;
 
 	/**
-	 * The maximum amount of time a player can be wall running or climbing before the system resets.
-	 * Set this to a value <= 0 to make it infinite.
+	 * Component tag for front wall checker.
+	 * This looks for a scene component.
 	*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
-		double MaxJetpackFuel;
+		FName FrontWallCheckTag;
 
 	/**
-	 * The force of the jetpack.
+	 * Component tag for right wall checker.
+	 * This looks for a scene component.
 	*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
-		double JetpackForce;
+		FName RightWallCheckTag;
 
 	/**
-	 * The amount of fuel that the jetpack needs to activate.
+	 * Component tag for left wall checker.
+	 * This looks for a scene component.
 	*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
-		double RequiredFuelForJetpack;
+		FName LeftWallCheckTag;
 
 	/**
-	 * The rate that the jetpack drains every frame
+	 * The default capsule size for the character.
+	 * X = Radius
+	 * Y = Height
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
-		double JetpackDrainRate;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Character")
+		FVector2D DefaultCapsuleSize;
 
 	/**
-	 * The rate that the jetpack refuels every frame.
+	 * The mesh location for doing things like going prone.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
-		double JetpackRefuelRate;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Character")
+		FVector DefaultMeshLocation;
 
 	/**
-	 * The maximum amount of time a player can be wall running or climbing before the system resets.
-	 * Set this to a value <= 0 to make it infinite.
+	 * The velocity to add to the character when double jumping.
+	 * If your owner is a character, this is typically run through the LaunchCharacter function.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
-		double MaxWallRun_ClimbTime;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Jumping")
+		FVector DoubleJumpVelocity;
 
 	/**
-	 * The maximum amount of time a player can be blinking
+	 * The velocity to add to the character when custom jumping.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Blink")
-		double MaxBlinkTime;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Jumping")
+		FVector CustomJumpVelocity;
 
 	/**
-	 * The value that we set a character's braking friction when sliding.
+	 * The number of samples the server keeps in the trajectory history.
+	 * The history covers TrajectoryCapacity * TrajectoryRecordInterval seconds.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Crouching/Sliding")
-		double SlideBrakingFriction;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Trajectory", meta = (ClampMin = "1"))
+		int32 TrajectoryCapacity;
 
 	/**
-	 * The maximum amount of time a player can be dashing
+	 * How often (in seconds) the server records a trajectory sample.
+	 * 0 = every tick.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Dash")
-		double MaxDashTime;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Trajectory", meta = (ClampMin = "0"))
+		float TrajectoryRecordInterval;
 
 	/**
-	 * The maximum amount of time a player can be hovering
+	 * If true, this component registers with the significance manager on clients.
+	 * Low significance components skip montages, hide their parachute and tick less often.
+	 * Your project still needs to call USignificanceManager::Update with the player viewpoints.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Hover")
-		double MaxHoverTime;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Significance")
+		bool bUseSignificance;
 
 	/**
-	 * The maximum amount of time a player can be rolling
+	 * The tag we register with the significance manager.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Roll")
-		double MaxRollTime;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Significance")
+		FName SignificanceTag;
 
 	/**
-	 * The maximum amount of time a player can be sliding before the system resets.
-	 * Set this to a value <= 0 to make it infinite.
+	 * The distance from a viewpoint where the owner has no significance.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Crouching/Sliding")
-		double MaxSlideTime;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Significance")
+		double SignificanceMaxDistance;
 
 	/**
-	 * The force to add to the slide.
+	 * The owner's bounds radius divided by distance that is needed to have any significance.
+	 * This is a cheap approximation of screen size.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Crouching/Sliding")
-		double SlideForce;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Significance")
+		double SignificanceMinScreenSize;
 
 	/**
-	 * The force to add to the slide.
+	 * The scalar applied to significance if the owner was not recently rendered.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Sprinting")
-		double SprintSpeed;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Significance")
+		double NotRenderedSignificanceScalar;
 
 	/**
-	 * Used to scale the launch velocity when we finish wall run checks.
+	 * Significance values below this are considered low significance.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
-		double WallRun_ClimbLaunchVelocityScalar;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Significance")
+		double LowSignificanceThreshold;
 
 	/**
-	 * The owner's velocity that is needed to be considered valid for sliding.
+	 * The tick interval used while the component has low significance.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Crouching/Sliding")
-		double RequiredSlideSpeed;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Significance")
+		float LowSignificanceTickInterval;
 
 	/**
-	 * The owner's max acceleration when parachuting.
+	 * The longest time between replay keyframes. State and mode transitions always write one.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Parachute")
-		double ParachuteMaxAcceleration;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Replay", meta = (ClampMin = "0"))
+		double ReplayKeyframeInterval;
 
 	/**
-	 * The owner's distance to the nearest floor that is needed to deploy the parachute.
-	 * This is called separately in CanDeployParachute.
-	 * By default CanDelpoyParachute is not implemented in this component.
-	 * I have decided to separate it so you can implement it yourself since I see a lot of use cases where you will want to do it in other ways.
+	 * Every this many replay keyframes one is stored whole instead of as a delta.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Parachute")
-		double RequiredDistanceToDeployParachute;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Replay", meta = (ClampMin = "1"))
+		int32 ReplayFullKeyframeInterval;
 
 	/**
-	 * The distance we trace from our owner location to find the floor.
+	 * The longest simulation step. Longer frames are split into substeps, so movement on a low tick rate server matches a high one.
+	 * Set this to a value <= 0 to step once per frame.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Movement")
-		double FloorCheckDistance;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Simulation")
+		double MaxSimSubstepTime;
 
 	/**
-	 * The force we add to our blink velocity.
+	 * The most substeps in one frame. Longer frames use longer substeps.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Blink")
-		double BlinkForce;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Simulation", meta = (ClampMin = "1"))
+		int32 MaxSimSubsteps;
 
 	/**
-	 * The force we scale to our dash velocity.
+	 * Step the simulation at FixedTickRate instead of once per frame, numbering every step so it can be rolled back.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Dash")
-		double DashForce;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Rollback")
+		bool bFixedTickSimulation;
 
 	/**
-	 * The force we add to our roll velocity.
+	 * Simulation steps per second with bFixedTickSimulation.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Dash")
-		double RollForce;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Rollback", meta = (ClampMin = "1"))
+		int32 FixedTickRate;
 
 	/**
-	 * The socket we attach the parachute actor to.
+	 * The most fixed steps to run in one frame. Time beyond that is dropped so a long hitch doesn't snowball.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Parachute")
-		FName ParachuteAttachSocket;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Rollback", meta = (ClampMin = "1"))
+		int32 MaxFixedTicksPerFrame;
 
 	/**
-	 * Component tag for front wall checker.
-	 * This looks for a scene component.
+	 * How many fixed steps back we can rewind. Allocated once in BeginPlay.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
-		FName FrontWallCheckTag;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AdvancedMovement|Rollback", meta = (ClampMin = "1"))
+		int32 RollbackFrames;
 
-	/**
-	 * Component tag for right wall checker.
-	 * This looks for a scene component.
-	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
-		FName RightWallCheckTag;
-
-	/**
-	 * Component tag for left wall checker.
-	 * This looks for a scene component.
-	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Climbing/WallRun")
-		FName LeftWallCheckTag;
-
-	/**
-	 * The default capsule size for the character.
-	 * X = Radius
-	 * Y = Height
-	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Character")
-		FVector2D DefaultCapsuleSize;
-
-	/**
-	 * The mesh location for doing things like going prone.
-	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Character")
-		FVector DefaultMeshLocation;
+#pragma endregion
 
-	/**
-	 * The velocity to add to the character when double jumping.
-	 * If your owner is a character, this is typically run through the LaunchCharacter function.
-	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Jumping")
-		FVector DoubleJumpVelocity;
+#pragma region DEPRECATED
 
 	/**
-	 * The velocity to add to the character when custom jumping.
+	 * Tuning that used to be set per component. Moved to MovementConfig and TuningOverrides.
+	 * These are kept so saved values and Blueprint graphs still load. Values that differ from the defaults below
+	 * move into TuningOverrides on load and at BeginPlay, after which the property goes back to its default.
+	 * Read GetMovementTuning and write SetTuningOverride instead.
 	*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedMovement|Jumping")
-		FVector CustomJumpVelocity;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		int32 AllowedNumberOfDoubleJumps;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double WallDetectTraceRadius;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double RequiredSlideAngle;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double MaxJetpackFuel;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double JetpackForce;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double RequiredFuelForJetpack;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double JetpackDrainRate;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double JetpackRefuelRate;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double MaxWallRun_ClimbTime;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double MaxBlinkTime;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		int32 MaxBlinkCharges;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double BlinkChargeCooldown;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double SlideBrakingFriction;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double MaxDashTime;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		int32 MaxDashCharges;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double DashChargeCooldown;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double MaxHoverTime;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double MaxRollTime;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		int32 MaxRollCharges;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double RollChargeCooldown;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double MaxSlideTime;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double SlideForce;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double SprintSpeed;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		bool bUseSprintStamina;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double MaxSprintStamina;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double SprintStaminaDrainRate;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double SprintStaminaRegenRate;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double WallRun_ClimbLaunchVelocityScalar;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double RequiredSlideSpeed;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double ParachuteMaxAcceleration;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double RequiredDistanceToDeployParachute;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double FloorCheckDistance;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double BlinkForce;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double DashForce;
+	UPROPERTY(BlueprintReadWrite, Category = "AdvancedMovement|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Moved to the movement config. Use GetMovementTuning and SetTuningOverride."))
+		double RollForce;
 
 #pragma endregion
 
@@ -645,12 +734,19 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	// Called when the game ends
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+	virtual void PostLoad() override;
+
 public:	
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
 #pragma endregion
 
 #pragma region NETWORKING
@@ -662,6 +758,14 @@ public:
 		void Server_UpdateTransform(FTransform Transform);
 	bool Server_UpdateTransform_Validate(FTransform Transform);
 
+	/**
+	 * Move owner back to the newest trajectory sample that is at least SecondsAgo old.
+	 * If bGrounded == true this is the last safe ground point, otherwise the last air point.
+	*/
+	UFUNCTION(Server, Reliable, WithValidation, BlueprintCallable, Category = "AdvancedMovement|Trajectory")
+		void Server_RewindTrajectory(double SecondsAgo, bool bGrounded = true);
+	bool Server_RewindTrajectory_Validate(double SecondsAgo, bool bGrounded = true);
+
 	/**
 	 * Set current jetpack fuel.
 	*/
@@ -752,11 +856,14 @@ public:
 
 	/**
 	 * Do the actual climb function.
-	 * This launches the character, sets the movement type and sets our climb time from delta time.
+	 * This launches the character, sets the movement type and starts the climb timer if it isn't running.
+	 * DeltaTime is only kept for compatibility, the climb timer is measured from the server world time.
+	 * ClientTime is the server world time the client climbed at, the server rewinds to it to check the wall was there.
+	 * Pass a value < 0 to use the current time.
 	*/
 	UFUNCTION(Server, Reliable, WithValidation, BlueprintCallable, Category = "AdvancedMovement|Input")
-		void Server_DoClimb(EMovementAnimType AnimType, FVector LaunchVelocity, double DeltaTime);
-	bool Server_DoClimb_Validate(EMovementAnimType AnimType, FVector LaunchVelocity, double DeltaTime);
+		void Server_DoClimb(EMovementAnimType AnimType, FVector LaunchVelocity, double DeltaTime, double ClientTime = -1.f);
+	bool Server_DoClimb_Validate(EMovementAnimType AnimType, FVector LaunchVelocity, double DeltaTime, double ClientTime = -1.f);
 
 	/**
 	 * Do an advanced jump.
@@ -835,10 +942,12 @@ public:
 
 	/**
 	 * Handle blinking.
+	 * ClientTime is the server world time the client blinked at, the server rewinds to it to check the blink path.
+	 * Pass a value < 0 to use the current time.
 	*/
 	UFUNCTION(Server, Reliable, WithValidation, BlueprintCallable, Category = "AdvancedMovement|Blink")
-		void Server_Blink(bool bPressed, FVector Direction, bool bForceEnd);
-	bool Server_Blink_Validate(bool bPressed, FVector Direction, bool bForceEnd);
+		void Server_Blink(bool bPressed, FVector Direction, bool bForceEnd, double ClientTime = -1.f);
+	bool Server_Blink_Validate(bool bPressed, FVector Direction, bool bForceEnd, double ClientTime = -1.f);
 
 	/**
 	 * Handle blinking.
@@ -878,6 +987,13 @@ public:
 	UFUNCTION(Client, Reliable, BlueprintCallable, Category = "AdvancedMovement|Animations")
 		void Client_Jump(bool bPressed);
 
+	/**
+	 * Correct the owning client after the server rejected a climb or blink.
+	 * Only the location, velocity and movement mode are sent.
+	*/
+	UFUNCTION(Client, Reliable, Category = "AdvancedMovement|Networking")
+		void Client_CorrectMovement(FVector Location, FVector Velocity, EAdvancedMovementMode Mode);
+
 
 #pragma endregion
 
@@ -895,6 +1011,126 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Movement")
 		void RestoreLastMovementMode();
 
+	/**
+	 * Copy GetTuning() into the config the tick reads.
+	 * This is done on every movement state or mode transition, call it after changing tuning at runtime to apply it sooner.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Movement")
+		void RefreshSimConfig();
+
+	/**
+	 * Use a different config asset. Pass null to use the defaults.
+	 * Authority only, the config replicates to clients.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Config")
+		void SetMovementConfig(USymplMovementConfig* Config);
+
+	/**
+	 * Override one tuning property for this component only.
+	 * Authority only, the overrides replicate to clients.
+	 * Returns false if the tuning has no numeric or bool property with that name, or we don't have authority.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Config")
+		bool SetTuningOverride(FName Property, double Value);
+
+	/**
+	 * Remove a per instance tuning override. Authority only.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Config")
+		void RemoveTuningOverride(FName Property);
+
+	/**
+	 * Return the tuning this component uses, MovementConfig's tuning with TuningOverrides applied.
+	*/
+	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Config", meta = (CompactNodeTitle = "Tuning"))
+		FSymplMovementTuning GetMovementTuning() const { return GetTuning(); }
+
+	//The tuning this component uses.
+	const FSymplMovementTuning& GetTuning() const { return ActiveTuning ? *ActiveTuning : USymplMovementConfig::GetDefaultTuning(); }
+
+	/**
+	 * Save the full movement state into Snapshot. Reuse the same snapshot to save every frame without allocating.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Snapshot")
+		void SaveSnapshot(UPARAM(ref) FSymplMovementSnapshot& Snapshot) const;
+
+	/**
+	 * Put the movement state back to a saved snapshot. Returns false and changes nothing if the snapshot can't be read.
+	 * Ability timers and meters are shifted by the time since the save, so they continue where they were.
+	 * States we leave or enter get their owner side effects (crouch, capsule, character movement mode, friction,
+	 * acceleration and the parachute actor) the same as a normal transition.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Snapshot")
+		bool RestoreSnapshot(const FSymplMovementSnapshot& Snapshot);
+
+	//Copy the movement state without serializing it.
+	void GetSnapshotState(FSymplMovementSnapshotState& State) const;
+
+	//Put the movement state back to State, see RestoreSnapshot. Times in State must already be on our clock.
+	void SetSnapshotState(const FSymplMovementSnapshotState& State);
+
+	/**
+	 * Record our movement to a replay track in Saved/Replays/SymplMovement, or to Filename if it is a full path.
+	 * While an engine replay is recording the track is stamped with its clock, and the movement state is left out of the engine replay.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Replay")
+		bool StartReplayRecording(const FString& Filename);
+
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Replay")
+		void StopReplayRecording();
+
+	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Replay")
+		bool IsRecordingReplay() const { return ReplayRecorder.IsValid() && ReplayRecorder->IsRecording(); }
+
+	/**
+	 * Play back a replay track recorded with StartReplayRecording. The movement state follows the track instead of being simulated until it ends.
+	 * Only drives the movement state and animations, position comes from the engine replay or whatever moves the owner.
+	 * While an engine replay is playing the track follows its time, including scrubbing, and stays loaded past the end.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Replay")
+		bool StartReplayPlayback(const FString& Filename);
+
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Replay")
+		void StopReplayPlayback();
+
+	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Replay")
+		bool IsPlayingReplay() const { return ReplayPlayer.IsValid(); }
+
+	/**
+	 * The number of the next fixed simulation step.
+	*/
+	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Rollback")
+		int32 GetSimFrame() const { return SimFrame; }
+
+	/**
+	 * Put the movement state and the owner's transform and velocity back to the start of Frame.
+	 * The rpcs and broadcasts for the restored states already went out when they happened, so none are sent again.
+	 * Returns false if Frame is older than RollbackFrames or hasn't been simulated.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Rollback")
+		bool Rewind(int32 Frame);
+
+	/**
+	 * Step the simulation from the current frame up to ToFrame with the stored inputs, correcting the stored states on the way.
+	 * Only the movement state is stepped. The owner isn't moved and no rpcs are sent until the last step, which is applied once.
+	 * The owner's movement component is left to the game's rollback.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Rollback")
+		void Resimulate(int32 ToFrame);
+
+	/**
+	 * Rewind to Frame and resimulate back up to the current frame. The owner keeps its current transform and velocity.
+	 * A movement mode that differs afterwards is broadcast once.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Rollback")
+		bool Rollback(int32 Frame);
+
+	/**
+	 * Replace the movement input stored for Frame, such as a late remote input. Rollback to Frame to apply it.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Rollback")
+		bool SetFrameInput(int32 Frame, FVector MoveInput);
+
 	/**
 	 * Set character movement mode to last character movement mode.
 	*/
@@ -913,6 +1149,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Animations")
 		double ReplicatedMontage_FromAnimStruct(FSymplMovementAnimation Anim);
 
+	/**
+	 * Async load every animation referenced by the animations struct and keep them resident. Nothing is played.
+	 * This is called from Server_Initialize if bWarmUpAnimations == true.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Animations")
+		void WarmUpAnimations(const FSymplMovementAnimations& Animations);
+
 	/**
 	 * Movement input function.
 	*/
@@ -943,6 +1186,42 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Input")
 		void MoveToLastAirLocation();
 
+	/**
+	 * Call Server_Dash unless we can already tell the server would refuse the press.
+	 * Presses are checked against the replicated charges and state, so mashing dash without charges sends nothing.
+	 * Returns false if the press was dropped.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Dash")
+		bool TryDash(bool bPressed, FVector Direction);
+
+	/**
+	 * Call Server_Blink unless we can already tell the server would refuse the press.
+	 * Returns false if the press was dropped.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Blink")
+		bool TryBlink(bool bPressed, FVector Direction);
+
+	/**
+	 * Call Server_Roll unless we can already tell the server would refuse the press.
+	 * Returns false if the press was dropped.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Roll")
+		bool TryRoll(bool bPressed, FVector Direction);
+
+	/**
+	 * Copy the trajectory history from oldest to newest.
+	 * The history is only recorded on the server.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Trajectory")
+		void GetTrajectory(TArray<FSymplTrajectorySample>& OutSamples) const;
+
+	/**
+	 * Get the interpolated trajectory sample at a server world time.
+	 * Returns false if the time is older than the history.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Trajectory")
+		bool GetTrajectorySampleAtTime(double Time, FSymplTrajectorySample& OutSample) const;
+
 #pragma endregion
 
 public:
@@ -1007,19 +1286,19 @@ public:
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure,Category = "AdvancedMovement|Getters",meta = (CompactNodeTitle = "MovementType"))
-		TEnumAsByte<EMovementAnimType> GetCurrentMovementType() { return CurrentMovementType; }
+		TEnumAsByte<EMovementAnimType> GetCurrentMovementType() { return RuntimeState.CurrentMovementType; }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "MovementMode"))
-		TEnumAsByte<EAdvancedMovementMode> GetCurrentMovementMode() { return CurrentMovementMode; }
+		TEnumAsByte<EAdvancedMovementMode> GetCurrentMovementMode() { return RuntimeState.CurrentMovementMode; }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "LastMovementMode"))
-		TEnumAsByte<EAdvancedMovementMode> GetLastMovementMode() { return LastMovementMode; }
+		TEnumAsByte<EAdvancedMovementMode> GetLastMovementMode() { return RuntimeState.LastMovementMode; }
 
 	/**
 	 * Return the value.
@@ -1031,127 +1310,151 @@ public:
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "ZeroG"))
-		bool ZeroGMovement() { return bZeroGMovement; }
+		bool ZeroGMovement() { return HasMovementState(ESymplMovementState::ZeroG); }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "JetpackActive"))
-		bool JetpackActive() { return bJetpackActive; }
+		bool JetpackActive() { return HasMovementState(ESymplMovementState::Jetpack); }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure,Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "DidJump"))
-		bool DidJump() { return bDidJump; }
+		bool DidJump() { return RuntimeState.bDidJump; }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "IsParachuting"))
-		bool IsParachuting() { return bIsParachuting; }
+		bool IsParachuting() { return HasMovementState(ESymplMovementState::Parachuting); }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "IsInitialized"))
-		bool IsInitialized() { return bInitialized; }
+		bool IsInitialized() { return RuntimeState.bInitialized; }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "AutoRunEnabled"))
-		bool IsAutoRunEnabled() { return bAutoRunEnabled; }
+		bool IsAutoRunEnabled() { return RuntimeState.bAutoRunEnabled; }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "Sliding"))
-		bool IsSliding() { return bSliding; }
+		bool IsSliding() { return HasMovementState(ESymplMovementState::Sliding); }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "Crouching"))
-		bool IsCrouching() { return bCrouching; }
+		bool IsCrouching() { return HasMovementState(ESymplMovementState::Crouching); }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "Dashing"))
-		bool IsDashing() { return bDashing; }
+		bool IsDashing() { return HasMovementState(ESymplMovementState::Dashing); }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "Blinking"))
-		bool IsBlinking() { return bBlinking; }
+		bool IsBlinking() { return HasMovementState(ESymplMovementState::Blinking); }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "Hovering"))
-		bool IsHovering() { return bHovering; }
+		bool IsHovering() { return HasMovementState(ESymplMovementState::Hovering); }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "Sprinting"))
-		bool IsSprinting() { return bSprinting; }
+		bool IsSprinting() { return HasMovementState(ESymplMovementState::Sprinting); }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "Prone"))
-		bool IsProne() { return bProne; }
+		bool IsProne() { return HasMovementState(ESymplMovementState::Prone); }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "DoubleJumpCounter"))
-		int32 GetDoubleJumpCounter() { return DoubleJumpCounter; }
+		int32 GetDoubleJumpCounter() { return RuntimeState.DoubleJumpCounter; }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "Forward"))
-		double GetForwardInput() { return ForwardInput; }
+		double GetForwardInput() { return RuntimeState.ForwardInput; }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "Right"))
-		double GetRightInput() { return RightInput; }
+		double GetRightInput() { return RuntimeState.RightInput; }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "Up"))
-		double GetUpInput() { return UpInput; }
+		double GetUpInput() { return RuntimeState.UpInput; }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "CurrentJetpackFuel"))
-		double GetCurrentJetpackFuel() { return CurrentJetpackFuel; }
+		double GetCurrentJetpackFuel() { return RuntimeState.JetpackFuel.GetValue(GetServerWorldTime()); }
+
+	/**
+	 * Return the value.
+	*/
+	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "SprintStamina"))
+		double GetSprintStamina() { return RuntimeState.SprintStamina.GetValue(GetServerWorldTime()); }
+
+	/**
+	 * Return the number of dash charges, including the part of the one that is recharging.
+	*/
+	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "DashCharges"))
+		double GetDashCharges() { return DashCharges.GetValue(GetServerWorldTime()); }
+
+	/**
+	 * Return the number of blink charges, including the part of the one that is recharging.
+	*/
+	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "BlinkCharges"))
+		double GetBlinkCharges() { return BlinkCharges.GetValue(GetServerWorldTime()); }
+
+	/**
+	 * Return the number of roll charges, including the part of the one that is recharging.
+	*/
+	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "RollCharges"))
+		double GetRollCharges() { return RollCharges.GetValue(GetServerWorldTime()); }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "ClimbTime"))
-		double GetClimbTime() { return ClimbTime; }
+		double GetClimbTime() { return GetAbilityTime(RuntimeState.ClimbStartTime); }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "SlideTime"))
-		double GetSlideTime() { return SlideTime; }
+		double GetSlideTime() { return GetAbilityTime(RuntimeState.SlideStartTime); }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "HoverTime"))
-		double GetHoverTime() { return HoverTime; }
+		double GetHoverTime() { return GetAbilityTime(RuntimeState.HoverStartTime); }
 
 	/**
 	 * Return the value.
@@ -1163,13 +1466,13 @@ public:
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "SlopeAngle"))
-		double GetCurrentSlopeAngle () { return CurrentSlopeAngle; }
+		double GetCurrentSlopeAngle () { return RuntimeState.CurrentSlopeAngle; }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "CurrentSlopeSpeedScalar"))
-		double GetCurrentSlopeSpeedScalar() { return CurrentSlopeSpeedScalar; }
+		double GetCurrentSlopeSpeedScalar() { return RuntimeState.CurrentSlopeSpeedScalar; }
 
 	/**
 	 * Return the value.
@@ -1181,42 +1484,55 @@ public:
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "CurrentDashDirection"))
-		FVector GetCurrentDashDirection() {return CurrentDashDirection;}
+		FVector GetCurrentDashDirection() {return RuntimeState.CurrentDashDirection;}
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "CurrentBlinkDirection"))
-		FVector GetCurrentBlinkDirection() { return CurrentBlinkDirection; }
+		FVector GetCurrentBlinkDirection() { return RuntimeState.CurrentBlinkDirection; }
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "CurrentRollDirection"))
-		FVector GetCurrentRollDirection() { return CurrentRollDirection; }
+		FVector GetCurrentRollDirection() { return RuntimeState.CurrentRollDirection; }
 	
 	/**
 	 * Return FVector(Forward,Right,Up).
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "InputDir"))
-		FVector GetInputDirection() { return FVector(ForwardInput,RightInput,UpInput); }
+		FVector GetInputDirection() { return FVector(RuntimeState.ForwardInput,RuntimeState.RightInput,RuntimeState.UpInput); }
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "LastGroundLocation"))
-		FVector GetLastGroundLocation() { return LastGroundLocation; }
+		FVector GetLastGroundLocation() const;
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "LastAirLocation"))
-		FVector GetLastAirLocation() { return LastAirLocation; }
+		FVector GetLastAirLocation() const;
+
+	/**
+	 * Return the synchronized server world time.
+	*/
+	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "ServerTime"))
+		double GetServerWorldTime() const;
 
 	/**
 	 * Return the value.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (CompactNodeTitle = "CurrentVelocity"))
-		FVector GetCurrentVelocity() { return CurrentVelocity; }
+		FVector GetCurrentVelocity() { return RuntimeState.CurrentVelocity; }
+
+	/**
+	 * Return the last published anim snapshot.
+	 * This is thread safe and can be called from NativeThreadSafeUpdateAnimation or thread safe anim bp functions.
+	*/
+	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Getters", meta = (BlueprintThreadSafe, CompactNodeTitle = "AnimSnapshot"))
+		FSymplMovementAnimSnapshot GetAnimSnapshot() const;
 
 
 #pragma endregion
@@ -1227,7 +1543,7 @@ public:
 	 * A standard input blocker if the character is sliding, dashing, rolling or hovering.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Jumping", meta = (CompactNodeTitle = "CanDoubleJump"))
-		bool CanMove() { return !bSliding && !bDashing && !bRolling && !bHovering; }
+		bool CanMove() { return SymplMovementStateMachine::CanMove(GetMovementState()); }
 
 	/**
 	 * True if the player can deploy their parachute.
@@ -1236,11 +1552,17 @@ public:
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Jumping", meta = (CompactNodeTitle = "CanDoubleJump"))
 		bool CanDeployParachute();
 
+	/**
+	 * True if the player has the stamina to start sprinting.
+	*/
+	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Sprinting", meta = (CompactNodeTitle = "CanSprint"))
+		bool CanSprint() { return !GetTuning().bUseSprintStamina || !RuntimeState.SprintStamina.IsEmpty(GetServerWorldTime()); }
+
 	/**
 	 * True if the player can jump
 	*/
 	UFUNCTION(BlueprintPure,Category = "AdvancedMovement|Jumping", meta = (CompactNodeTitle = "CanDoubleJump"))
-		bool CanDoubleJump() { return bDidJump && GetDoubleJumpCounter() <= AllowedNumberOfDoubleJumps; }
+		bool CanDoubleJump() { return RuntimeState.bDidJump && GetDoubleJumpCounter() <= GetTuning().AllowedNumberOfDoubleJumps; }
 
 	/**
 	 * Check to see if the player can slide by determining velocity.
@@ -1252,25 +1574,25 @@ public:
 	 * Check to see if the player can dash by determining velocity.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Sliding", meta = (CompactNodeTitle = "CanDash"))
-		bool CanDash() { return !bRolling && !bBlinking && DashTime <= MaxDashTime; }
+		bool CanDash() { return SymplMovementStateMachine::CanEnter(GetMovementState(), ESymplMovementState::Dashing) && GetAbilityTime(RuntimeState.DashStartTime) <= GetTuning().MaxDashTime && (HasMovementState(ESymplMovementState::Dashing) || HasAbilityCharge(DashCharges, GetTuning().DashChargeCooldown)); }
 
 	/**
 	 * Check to see if the player can roll by determining velocity.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Sliding", meta = (CompactNodeTitle = "CanRoll"))
-		bool CanRoll() { return !bDashing && !bBlinking && RollTime <= MaxRollTime; }
+		bool CanRoll() { return SymplMovementStateMachine::CanEnter(GetMovementState(), ESymplMovementState::Rolling) && GetAbilityTime(RuntimeState.RollStartTime) <= GetTuning().MaxRollTime && (HasMovementState(ESymplMovementState::Rolling) || HasAbilityCharge(RollCharges, GetTuning().RollChargeCooldown)); }
 
 	/**
 	 * Check to see if the player can blink by determining velocity.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Sliding", meta = (CompactNodeTitle = "CanBlink"))
-		bool CanBlink() { return !bDashing && !bRolling && BlinkTime <= MaxBlinkTime; }
+		bool CanBlink() { return SymplMovementStateMachine::CanEnter(GetMovementState(), ESymplMovementState::Blinking) && GetAbilityTime(RuntimeState.BlinkStartTime) <= GetTuning().MaxBlinkTime && (HasMovementState(ESymplMovementState::Blinking) || HasAbilityCharge(BlinkCharges, GetTuning().BlinkChargeCooldown)); }
 
 	/**
 	 * Check to see if the player can blink by determining velocity.
 	*/
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Sliding", meta = (CompactNodeTitle = "CanBlink"))
-		bool CanHover() { return bEnableHover && HoverTime < MaxHoverTime; }
+		bool CanHover() { return bEnableHover && GetAbilityTime(RuntimeState.HoverStartTime) < GetTuning().MaxHoverTime; }
 
 #pragma endregion
 
@@ -1280,6 +1602,205 @@ public:
 	UFUNCTION(BlueprintPure, Category = "AdvancedMovement", meta = (CompactNodeTitle = "FindFloor"))
 		bool FindFloor(FHitResult& OutHit);
 
+	/**
+	 * Return the value.
+	*/
+	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Significance", meta = (CompactNodeTitle = "Significance"))
+		double GetSignificance() const { return CurrentSignificance; }
+
+	/**
+	 * Return the value.
+	*/
+	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Significance", meta = (CompactNodeTitle = "LowSignificance"))
+		bool IsLowSignificance() const { return bLowSignificance; }
+
+	/**
+	 * Return the number of calls to an rpc the server has rejected for this component.
+	*/
+	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Networking", meta = (CompactNodeTitle = "RejectedRpcs"))
+		int32 GetRejectedRpcCount(ESymplMovementRpc Rpc) const { return RpcRateLimiter.GetRejectedCount(Rpc); }
+
+	/**
+	 * Return the number of rpc calls the server has rejected for this component.
+	*/
+	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Networking", meta = (CompactNodeTitle = "TotalRejectedRpcs"))
+		int32 GetTotalRejectedRpcCount() const { return RpcRateLimiter.GetTotalRejectedCount(); }
+
+	/**
+	 * Return per rpc and per replicated property network stats for this component.
+	 * Only collected on the server while Sympl.NetStats is 1.
+	*/
+	UFUNCTION(BlueprintPure, Category = "AdvancedMovement|Networking", meta = (CompactNodeTitle = "NetStats"))
+		FSymplMovementNetStats GetNetStats() const;
+
+	//True if Sympl.NetStats is on.
+	static bool IsNetStatsEnabled();
+
+protected:
+
+	//Copy the current state into the back anim snapshot and publish it.
+	virtual void PublishAnimSnapshot();
+
+	//Rate the owner for a single viewpoint.
+	virtual float CalculateSignificance(const FTransform& Viewpoint) const;
+
+	//Apply the new significance to montages, the parachute and tick rate.
+	virtual void SetSignificance(float Significance);
+
+	//Recalculate the tick LOD interval from our net role and distance to the local viewer.
+	virtual void UpdateTickLOD();
+
+	//Set the tick interval to the slowest of the default, tick LOD and significance intervals.
+	void UpdateTickInterval();
+
+	//True if this tick should only run the cosmetic regions.
+	bool IsCosmeticOnlyTick() const;
+
+	//Spend a rate limit token for a server rpc. Calls we make from our own tick or rpc implementations are always accepted.
+	bool AcceptServerRpc(ESymplMovementRpc Rpc);
+
+	//Count a server rpc that failed a plausibility check.
+	void RejectServerRpc(ESymplMovementRpc Rpc);
+
+	//Sweep from where the owner was at ClientTime by Offset. ClientTime is clamped to the max rewind time.
+	bool RewoundSweep(double ClientTime, FVector Offset, double Radius, FHitResult& OutHit) const;
+
+	//True if the wall for AnimType was there when the client climbed.
+	virtual bool ValidateClientClimb(EMovementAnimType AnimType, double ClientTime) const;
+
+	//True if the blink path was open when the client blinked.
+	virtual bool ValidateClientBlink(FVector Direction, double ClientTime) const;
+
+	//Send the owning client our location, velocity and movement mode.
+	void SendMovementCorrection();
+
+	//Count an rpc in the net stats. Call on the server when a server rpc arrives or before sending a client or multicast rpc.
+	void RecordRpc(ESymplMovementRpc Rpc);
+
+	//Diff our replicated properties against the last replicated copy and count the changes.
+	void RecordPropertyChanges();
+
+	//Free the replicated property copy.
+	void ResetNetStats();
+
+	/**
+	 * True if we are running a server rpc that a remote client sent us.
+	 * Standalone games, listen server hosts, AI and internal calls are trusted and never validated or rate limited.
+	*/
+	bool IsClientServerRpc() const;
+
+	//Time an ability has been running, measured against the server world time so it reads the same on every machine.
+	double GetAbilityTime(double StartTime) const { return FSymplMovementSimState::GetElapsed(StartTime, GetServerWorldTime()); }
+
+	//True if an ability with these charges has a whole charge now. Always true when Cooldown <= 0.
+	bool HasAbilityCharge(const FSymplResourceMeter& Charges, double Cooldown) const { return Cooldown <= 0.f || Charges.GetValue(GetServerWorldTime()) >= 1.f - KINDA_SMALL_NUMBER; }
+
+	//Spend one charge and keep recharging at one per Cooldown. Does nothing when Cooldown <= 0.
+	void SpendAbilityCharge(FSymplResourceMeter& Charges, int32 MaxCharges, double Cooldown);
+
+	//Full charges for an ability.
+	static FSymplResourceMeter MakeAbilityCharges(int32 MaxCharges, double Cooldown, double Time);
+
+	//The start time member for a timed state, or nullptr if the state isn't timed.
+	double* GetStateStartTime(ESymplMovementState State);
+
+	//The active movement states.
+	ESymplMovementSimFlags GetMovementState() const { return (ESymplMovementSimFlags)RuntimeState.MovementStateFlags; }
+
+	//True if a movement state is active.
+	bool HasMovementState(ESymplMovementState State) const { return SymplMovementStateMachine::IsActive(GetMovementState(), State); }
+
+	//Enter a movement state if the transition table allows it. Exits everything the state excludes and sets its movement mode.
+	//Returns true if the state is active afterwards.
+	bool EnterMovementState(ESymplMovementState State);
+
+	//Exit a movement state if it is active. Its mode stack entry is removed and, if the table asks for it,
+	//the mode goes back to the next state down the stack.
+	void ExitMovementState(ESymplMovementState State, bool bRestoreMode = true);
+
+	//Exit the state if it is active, otherwise enter it. Returns true if the state is active afterwards.
+	bool ToggleMovementState(ESymplMovementState State);
+
+	//Enter and exit actions that touch the owner. Called after the flag has changed.
+	virtual void OnEnterMovementState(ESymplMovementState State);
+	virtual void OnExitMovementState(ESymplMovementState State);
+
+	//Only call Server_SetMovementMode if the mode would change.
+	void SetMovementModeIfChanged(EAdvancedMovementMode Mode);
+
+	//Point our tuning at the config, or at our own copy if we have overrides, and listen for config changes.
+	void ApplyMovementConfig();
+
+	//Stop listening for config changes.
+	void UnbindMovementConfig();
+
+	//Run the owner side effects of entering or leaving every state in Flags, for state changes that don't go through Enter/ExitMovementState.
+	void ApplyOwnerMovementStates(ESymplMovementSimFlags Flags, bool bEnter);
+
+	//Spawn and attach the parachute actor if we don't have one. Authority only.
+	void SpawnParachuteActor();
+
+	//Detach and destroy the parachute actor if we have one.
+	void DestroyParachuteActor();
+
+	UFUNCTION()
+		void OnRep_MovementConfig();
+
+	//Move deprecated per component tuning that differs from the native defaults into TuningOverrides.
+	void MigrateDeprecatedTuning();
+
+	//Apply the replay track at the current playback time.
+	void TickReplayPlayback();
+
+	//The clock replay tracks are stamped with. The engine replay's time while one is recording or playing, the server world time otherwise.
+	double GetReplayTime() const;
+
+	//Step the simulation by one fixed tick of StepTime, storing the rollback frame first if bFixedTickSimulation is set.
+	void StepFixedTick(const FSymplMovementSimInput& Input, double StepTime);
+
+	//The fixed step time from bFixedTickSimulation or the server simulation rate, or 0 to step once per frame.
+	double GetFixedStepTime() const;
+
+	//True if we are simulating at the project's ServerSimulationRate.
+	bool IsServerFixedRate() const;
+
+	UFUNCTION()
+		void OnRep_LastSimTime();
+
+	//Replace the anim snapshot's speed, slope and velocity with values interpolated between the last two simulated states.
+	void InterpolateSimulatedProxy(FSymplMovementAnimSnapshot& Snapshot) const;
+
+	void OnMovementConfigChanged(USymplMovementConfig* Config);
+
+	//The movement mode including any change staged this frame.
+	EAdvancedMovementMode GetStagedMovementMode() const { return bHasPendingMovementMode ? PendingMovementMode.GetValue() : RuntimeState.CurrentMovementMode.GetValue(); }
+
+	//The mode a restore would go back to, including any change staged this frame.
+	EAdvancedMovementMode GetStagedLastMovementMode() const { return bHasPendingMovementMode ? PendingLastMovementMode.GetValue() : RuntimeState.LastMovementMode.GetValue(); }
+
+	//Commit the staged movement mode and broadcast a single transition.
+	void CommitMovementMode();
+
+	//Copy our state into a simulation state.
+	FSymplMovementSimState GatherSimState() const;
+
+	//Copy our tuning into a simulation config.
+	FSymplMovementSimConfig GatherSimConfig() const;
+
+	//Gather this tick's input for the simulation.
+	FSymplMovementSimInput GatherSimInput() const;
+
+	//Write a simulation step back into the component and apply its side effects to the owner.
+	virtual void ApplySimResult(const FSymplMovementSimResult& Result);
+
+	//Set the character movement max speed for the current movement mode.
+	void ApplyCharacterSpeed();
+
+	//ISymplMovementSimQueries
+	virtual double QuerySlopeAngle() const override;
+	virtual double QuerySlopeSpeedScalar(double SlopeAngle) const override;
+	virtual bool QueryModeSpeed(EAdvancedMovementMode Mode, double& OutSpeed) const override;
+
 private:
 
 #pragma region PROPERTIES
@@ -1324,165 +1845,160 @@ private:
 	UPROPERTY()
 		FSymplMovementAnimations CurrentMovementAnimations;
 
-	//The movement anim type for animations.
-	UPROPERTY(Replicated)
-		TEnumAsByte<EMovementAnimType> CurrentMovementType;
-
-	//The movement mode for adjusting speed.
-	UPROPERTY(Replicated)
-		TEnumAsByte<EAdvancedMovementMode> CurrentMovementMode;
-
-	//The last movement mode for adjusting speed.
-	UPROPERTY(Replicated)
-		TEnumAsByte<EAdvancedMovementMode> LastMovementMode;
+	//The streamable handle for the warmed up animations. Held so they stay resident.
+	TSharedPtr<FStreamableHandle> AnimationWarmUpHandle;
 
 	//The last movement mode for the character.
 	UPROPERTY(Replicated)
 		TEnumAsByte<EMovementMode> LastCharacterMovementMode;
 
-	//Determines if the player is in zero G.
-	UPROPERTY(Replicated)
-		bool bZeroGMovement;
+	//The movement mode staged this frame.
+	TEnumAsByte<EAdvancedMovementMode> PendingMovementMode;
 
-	//Determines if the player is in zero G.
-	UPROPERTY(Replicated)
-		bool bJetpackActive;
+	//The mode staged before PendingMovementMode, so a restore inside a frame still goes back one step.
+	TEnumAsByte<EAdvancedMovementMode> PendingLastMovementMode;
 
-	//Determines if the player is hovering.
-	UPROPERTY(Replicated)
-		bool bHovering;
+	//True if a movement mode change is waiting to be committed.
+	bool bHasPendingMovementMode;
 
-	//Determines if the player is parachuting.
-	UPROPERTY(Replicated)
-		bool bIsParachuting;
+	//True if PendingLastMovementMode, not the mode the frame started in, becomes LastMovementMode on commit.
+	bool bHasPendingLastMovementMode;
 
-	//Determines if the player did their first jump.
-	UPROPERTY(Replicated)
-		bool bDidJump;
+	//Modes pushed by active movement states. Server only, the top is what CurrentMovementMode replicates.
+	FSymplMovementModeStack ModeStack;
 
-	//Determines if the character is dashing.
+	//Per frame runtime state, packed so the tick reads a few contiguous cache lines.
 	UPROPERTY(Replicated)
-		bool bDashing;
+		FSymplMovementRuntimeState RuntimeState;
 
-	//Determines if the character is rolling.
-	UPROPERTY(Replicated)
-		bool bRolling;
+	//Tuning the simulation reads, copied from GetTuning() on state transitions so the tick doesn't read them.
+	FSymplMovementSimConfig SimConfig;
 
-	//Determines if the character is blinking.
-	UPROPERTY(Replicated)
-		bool bBlinking;
+	//The tuning we read. Points into the config asset, or at OverriddenTuning.
+	const FSymplMovementTuning* ActiveTuning;
 
-	//Determines if the character is prone.
-	UPROPERTY(Replicated)
-		bool bProne;
+	//Our own copy of the tuning. Only allocated when we have overrides.
+	TUniquePtr<FSymplMovementTuning> OverriddenTuning;
 
-	//Determines if the player is autorunning.
-	UPROPERTY(Replicated)
-		bool bAutoRunEnabled;
+	//The config we listen to for tuning changes.
+	TWeakObjectPtr<USymplMovementConfig> BoundConfig;
+	FDelegateHandle ConfigChangedHandle;
 
-	//Determines if the player has initialized the component.
-	UPROPERTY(Replicated)
-		bool bInitialized;
+	//Valid while recording a replay track.
+	TUniquePtr<FSymplMovementReplayRecorder> ReplayRecorder;
 
-	//Determines if the player has initialized the component.
-	UPROPERTY(Replicated)
-		bool bSprinting;
+	//Valid while playing a replay track.
+	TUniquePtr<FSymplMovementReplayPlayer> ReplayPlayer;
 
-	//Determines if the player is sliding.
-	UPROPERTY(Replicated)
-		bool bSliding;
+	//World time playback started at.
+	double ReplayPlaybackStartTime;
 
-	//Determines if the player is sliding.
-	UPROPERTY(Replicated)
-		bool bCrouching;
+	//The rollback frames of the last RollbackFrames fixed steps.
+	FSymplMovementRollbackBuffer RollbackBuffer;
 
-	//The number of times the player has double jumped.
-	UPROPERTY(Replicated)
-		int32 DoubleJumpCounter;
+	//The number of the next fixed step.
+	int32 SimFrame;
 
-	//Forward movement input.
-	UPROPERTY(Replicated)
-		double ForwardInput;
+	//Frame time not yet simulated by fixed steps.
+	double FixedTickAccumulator;
 
-	//Right movement input.
-	UPROPERTY(Replicated)
-		double RightInput;
+	//The share of the frame the step being gathered covers. Forces are integrated over the whole frame, so the simulation scales them by it.
+	double SimStepFrameFraction;
 
-	//Up movement input.
-	UPROPERTY(Replicated)
-		double UpInput;
+	//Server world time of the last fixed simulation step. Replicated to simulated proxies so they can place states in time.
+	UPROPERTY(ReplicatedUsing = OnRep_LastSimTime)
+		double LastSimTime;
 
-	//The amount of jetpack fuel we have.
-	UPROPERTY(Replicated)
-		double CurrentJetpackFuel;
+	//A simulated state as received by a simulated proxy.
+	struct FSimSample
+	{
+		double Time = -1.f;
+		FVector Velocity = FVector::ZeroVector;
+		double Speed = 0.f;
+		double SlopeAngle = 0.f;
+	};
 
-	//The angle of our walking slope.
-	UPROPERTY(Replicated)
-		double CurrentSlopeAngle;
+	//The previous and the latest simulated state.
+	FSimSample SimSamples[2];
 
-	//The speed scalar for slope angle.
+	//Dash charges. Only replicates when a charge is spent.
 	UPROPERTY(Replicated)
-		double CurrentSlopeSpeedScalar;
+		FSymplResourceMeter DashCharges;
 
-	//The total time that we have been climbing.
+	//Blink charges. Only replicates when a charge is spent.
 	UPROPERTY(Replicated)
-		double ClimbTime;
+		FSymplResourceMeter BlinkCharges;
 
-	//The total time that we have been rolling.
+	//Roll charges. Only replicates when a charge is spent.
 	UPROPERTY(Replicated)
-		double RollTime;
+		FSymplResourceMeter RollCharges;
 
-	//The total time that we have been dashing.
+	//The last braking friction for a character.
 	UPROPERTY(Replicated)
-		double DashTime;
+		double LastBrakingFriction;
 
-	//The total time that we have been blinking.
+	//The last max acceleration for a character.
 	UPROPERTY(Replicated)
-		double BlinkTime;
+		double LastMaxAcceleration;
 
-	//The total time that we have been climbing.
-	UPROPERTY(Replicated)
-		double SlideTime;
+	//Server side history of where the player has been. Not replicated.
+	FSymplTrajectoryHistory TrajectoryHistory;
 
-	//The total time that we have been climbing.
+	//The location of the newest grounded trajectory sample, replicated so clients can read it.
 	UPROPERTY(Replicated)
-		double HoverTime;
+		FVector LastGroundLocation;
 
-	//The current movement speed.
+	//The location of the newest airborne trajectory sample, replicated so clients can read it.
 	UPROPERTY(Replicated)
-		double CurrentSpeed;
+		FVector LastAirLocation;
 
-	//The last braking friction for a character.
-	UPROPERTY(Replicated)
-		double LastBrakingFriction;
+	//Server world time of the last trajectory sample.
+	double LastTrajectoryRecordTime;
 
-	//The last max acceleration for a character.
-	UPROPERTY(Replicated)
-		double LastMaxAcceleration;
+	//Double buffered anim snapshots. Only the game thread writes, anim worker threads read the published one.
+	FSymplMovementAnimSnapshot AnimSnapshots[2];
 
-	//The current dash direction.
-	UPROPERTY(Replicated)
-		FVector CurrentDashDirection;
+	/**
+	 * Sequence lock over AnimSnapshots. Odd while a snapshot is being written, incremented twice per publish.
+	 * The published snapshot is AnimSnapshots[(Sequence >> 1) & 1].
+	*/
+	std::atomic<uint32> AnimSnapshotSequence;
 
-	//The current blink direction.
-	UPROPERTY(Replicated)
-		FVector CurrentBlinkDirection;
+	//True if we registered with the significance manager.
+	bool bRegisteredSignificance;
 
-	//The current roll direction.
-	UPROPERTY(Replicated)
-		FVector CurrentRollDirection;
+	//True if our significance is below LowSignificanceThreshold.
+	bool bLowSignificance;
 
-	//The last location the player was on the ground.
-	UPROPERTY(Replicated)
-		FVector LastGroundLocation;
+	//The last significance from the significance manager.
+	double CurrentSignificance;
 
-	//The last location the player was on the ground.
-	UPROPERTY(Replicated)
-		FVector LastAirLocation;
+	//The tick interval we had before significance or tick LOD changed it.
+	float DefaultTickInterval;
 
-	//The current velocity of our player.
-	UPROPERTY(Replicated)
-		FVector CurrentVelocity;
+	//The tick interval from the tick LOD policy.
+	float TickLODInterval;
+
+	//World time of the last tick LOD update.
+	double LastTickLODUpdateTime;
+
+	//Token buckets and rejection counters for server rpcs.
+	FSymplRpcRateLimiter RpcRateLimiter;
+
+	//Greater than 0 while we are inside our own tick or a server rpc implementation.
+	int32 InternalCallDepth;
+
+	//Greater than 0 while Rewind or Rollback restore a frame. States are put back on the owner without rpcs or delegate broadcasts.
+	int32 RollbackDepth;
+
+	//Rpc and property counters.
+	FSymplNetStatsTracker NetStats;
+
+	//Our replicated properties, in the same order as the net stats.
+	TArray<FProperty*> NetStatsProperties;
+
+	//A copy of our replicated properties from the last replication.
+	TArray<uint8> NetStatsShadow;
 
 #pragma endregion
 
@@ -0,0 +1,186 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+
+#include "ESymplMovementRpc.h"
+#include "FSymplRpcRateLimit.h"
+
+#include "SymplAdvancedMovementSettings.generated.h"
+
+/**
+ * Project settings for the sympl advanced movement component.
+ * Found under Project Settings -> Plugins -> Sympl Advanced Movement.
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Sympl Advanced Movement"))
+class SYMPLADVANCEDMOVEMENT_API USymplAdvancedMovementSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	USymplAdvancedMovementSettings();
+
+	virtual FName GetCategoryName() const override { return "Plugins"; }
+
+#pragma region TICKLOD
+
+	/**
+	 * If true, components scale their tick interval by net role and distance to the local viewer.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "TickLOD")
+		bool bEnableTickLOD;
+
+	/**
+	 * The tick interval for components that have authority.
+	 * 0 = every frame.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "TickLOD", meta = (ClampMin = "0"))
+		float AuthorityTickInterval;
+
+	/**
+	 * The tick interval for components owned by the local player.
+	 * 0 = every frame.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "TickLOD", meta = (ClampMin = "0"))
+		float AutonomousProxyTickInterval;
+
+	/**
+	 * The tick interval for simulated proxies that are near the viewer.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "TickLOD", meta = (ClampMin = "0"))
+		float SimulatedProxyTickInterval;
+
+	/**
+	 * If true, simulated proxies only run the cosmetic parts of the tick (velocity, speed and the anim snapshot).
+	 * Slope traces, auto run, climbing, abilities, jetpack and locations are left to the server.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "TickLOD")
+		bool bSimulatedProxyCosmeticOnly;
+
+	/**
+	 * Simulated proxies further than this from the viewer start scaling towards FarTickInterval.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "TickLOD", meta = (ClampMin = "0"))
+		float NearDistance;
+
+	/**
+	 * Simulated proxies at or further than this from the viewer tick at FarTickInterval.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "TickLOD", meta = (ClampMin = "0"))
+		float FarDistance;
+
+	/**
+	 * The tick interval for simulated proxies at FarDistance.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "TickLOD", meta = (ClampMin = "0"))
+		float FarTickInterval;
+
+	/**
+	 * The tick interval for simulated proxies that have not been rendered recently.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "TickLOD", meta = (ClampMin = "0"))
+		float OffscreenTickInterval;
+
+	/**
+	 * How often (in seconds) a component recalculates its tick LOD.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "TickLOD", meta = (ClampMin = "0"))
+		float TickLODUpdateInterval;
+
+#pragma endregion
+
+#pragma region SIMULATION
+
+	/**
+	 * The rate (in Hz) components with authority simulate at on dedicated servers, independent of the server frame rate.
+	 * Lowers server cpu per player. 0 = every frame.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Simulation", meta = (ClampMin = "0"))
+		float ServerSimulationRate;
+
+	/**
+	 * If true and ServerSimulationRate is set, simulated proxies display speed, slope and velocity
+	 * interpolated between the last two simulated states instead of stepping at the server rate.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Simulation")
+		bool bInterpolateSimulatedProxies;
+
+#pragma endregion
+
+#pragma region RPCVALIDATION
+
+	/**
+	 * If true, server rpcs from clients are rate limited with a token bucket per rpc.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "RPCValidation")
+		bool bEnableRpcRateLimiting;
+
+	/**
+	 * The rate limit for rpcs that are not in RpcRateLimits.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "RPCValidation")
+		FSymplRpcRateLimit DefaultRpcRateLimit;
+
+	/**
+	 * Per rpc rate limits.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "RPCValidation")
+		TMap<ESymplMovementRpc, FSymplRpcRateLimit> RpcRateLimits;
+
+	/**
+	 * The furthest a client can move its owner with Server_UpdateTransform.
+	 * Set this to a value <= 0 to make it infinite.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "RPCValidation")
+		float MaxClientTransformDelta;
+
+	/**
+	 * How many seconds of draining or refueling a client reported jetpack fuel can be away from the server value.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "RPCValidation", meta = (ClampMin = "0"))
+		float JetpackFuelStepTolerance;
+
+	/**
+	 * The highest speed a client can set with Server_SetMovementSpeeds.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "RPCValidation", meta = (ClampMin = "0"))
+		float MaxClientMovementSpeed;
+
+#pragma endregion
+
+#pragma region REWINDVALIDATION
+
+	/**
+	 * If true, the server rewinds to the client's timestamp and sweeps to validate climbs and blinks.
+	 * This uses the component's trajectory history, so a lower TrajectoryRecordInterval gives more accurate results.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "RewindValidation")
+		bool bEnableRewindValidation;
+
+	/**
+	 * The furthest back (in seconds) the server will rewind for a client.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "RewindValidation", meta = (ClampMin = "0"))
+		float MaxRewindTime;
+
+	/**
+	 * Extra radius added to rewound sweeps to allow for interpolation error.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "RewindValidation", meta = (ClampMin = "0"))
+		float RewindTolerance;
+
+	/**
+	 * How far along the blink direction the server checks for blocking geometry.
+	*/
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "RewindValidation", meta = (ClampMin = "0"))
+		float BlinkProbeDistance;
+
+#pragma endregion
+
+	//Return the rate limit for an rpc.
+	const FSymplRpcRateLimit& GetRpcRateLimit(ESymplMovementRpc Rpc) const;
+
+};
@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+#if !UE_BUILD_SHIPPING
+
+class UWorld;
+class ACharacter;
+class AActor;
+
+/**
+ * Scripted scale benchmark for the advanced movement component.
+ * Spawns pawns for each scenario and count, measures component tick time, traces, rpcs and memory per component,
+ * and writes the results as csv and json to Saved/Profiling/SymplMovement so versions can be compared.
+ * Run from the console with Sympl.Benchmark, or headless with -nullrhi -ExecCmds="Sympl.Benchmark Quit".
+ * Sympl.BenchmarkSim runs the simulation core on its own without spawning anything.
+ * Sympl.BenchmarkRollback saves, rewinds and resimulates the simulation core the way a rollback game mode does every frame.
+ */
+class SYMPLADVANCEDMOVEMENT_API FSymplMovementBenchmark : public TSharedFromThis<FSymplMovementBenchmark>
+{
+
+public:
+
+	enum class EScenario : uint8
+	{
+		Idle,
+		Walk,
+		Sprint,
+		WallJump,
+		Dash,
+		Jetpack,
+		Parachute,
+		Max
+	};
+
+	struct FResult
+	{
+		//The scenario name.
+		FString Scenario;
+
+		//The number of pawns, or simulations for the sim core.
+		int32 Count = 0;
+
+		//The number of measured frames, or steps for the sim core.
+		int32 Frames = 0;
+
+		//Time spent in component ticks per frame.
+		double AvgFrameMs = 0.f;
+		double MaxFrameMs = 0.f;
+
+		//Time per component tick.
+		double AvgTickUs = 0.f;
+
+		//Traces and rpcs per frame across all components.
+		double TracesPerFrame = 0.f;
+		double RpcsPerFrame = 0.f;
+
+		//Memory per component.
+		int64 BytesPerComponent = 0;
+	};
+
+	FSymplMovementBenchmark(UWorld* InWorld, const TArray<int32>& InCounts, const TArray<EScenario>& InScenarios, int32 InFrames, bool bInQuitWhenDone);
+	~FSymplMovementBenchmark();
+
+	//Start ticking the benchmark.
+	void Start();
+
+	//True once every run has finished and the results were written.
+	bool IsDone() const { return !TickHandle.IsValid(); }
+
+	//The finished runs, followed by the simulation core once everything is done.
+	const TArray<FResult>& GetResults() const { return Results; }
+
+	//Run the simulation core for Count simulations and Steps steps.
+	static FResult RunSimulation(int32 Count, int32 Steps);
+
+	//Run Count simulations for Steps fixed ticks, rewinding RollbackFrames and resimulating them every tick.
+	static FResult RunRollback(int32 Count, int32 Steps, int32 RollbackFrames);
+
+	//Write results to Saved/Profiling/SymplMovement. Returns the csv path.
+	static FString WriteResults(const TArray<FResult>& Results);
+
+	static const TCHAR* GetScenarioName(EScenario Scenario);
+
+private:
+
+	bool Tick(float DeltaTime);
+
+	//Spawn the floor, walls and pawns for the current run.
+	void SpawnRun();
+
+	//Destroy everything we spawned.
+	void DespawnRun();
+
+	//Feed scripted input to the pawns for the current frame.
+	void DriveRun();
+
+	//Record the counters for the frame that just ran.
+	void MeasureFrame();
+
+	//Finish the current run and move on.
+	void FinishRun();
+
+	void Finish();
+
+	TWeakObjectPtr<UWorld> World;
+	TArray<int32> Counts;
+	TArray<EScenario> Scenarios;
+	int32 Frames;
+	int32 WarmUpFrames;
+	bool bQuitWhenDone;
+
+	//The current scenario and count index.
+	int32 RunIndex;
+
+	//Frame within the current phase.
+	int32 Frame;
+	bool bMeasuring;
+
+	TArray<TWeakObjectPtr<ACharacter>> Pawns;
+	TArray<TWeakObjectPtr<AActor>> Props;
+
+	FResult Current;
+	TArray<FResult> Results;
+	FTSTicker::FDelegateHandle TickHandle;
+};
+
+#endif
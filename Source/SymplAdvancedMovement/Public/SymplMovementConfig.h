@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+
+#include "FSymplMovementTuning.h"
+
+#include "SymplMovementConfig.generated.h"
+
+/**
+ * Shared movement tuning for advanced movement components.
+ * Components reference a config instead of each holding their own copy, and only copy it if they have per instance overrides.
+ * Changing the tuning in the editor, from SetTuning/SetTuningValue or with Sympl.SetTuning applies to every live component using the config.
+ * Those changes only affect this process. That keeps PIE servers and clients in sync because they share the asset,
+ * but in a networked game use the component's replicated SetTuningOverride instead.
+ */
+UCLASS(BlueprintType)
+class SYMPLADVANCEDMOVEMENT_API USymplMovementConfig : public UPrimaryDataAsset
+{
+
+	GENERATED_BODY()
+
+public:
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnTuningChanged, USymplMovementConfig*);
+
+	/**
+	 * The shared tuning.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AdvancedMovement", meta = (ShowOnlyInnerProperties))
+		FSymplMovementTuning Tuning;
+
+	/**
+	 * Replace the tuning and apply it to every component using this config in this process.
+	 * Not replicated, meant for the editor and PIE.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Config")
+		void SetTuning(const FSymplMovementTuning& InTuning);
+
+	/**
+	 * Change one tuning property and apply it to every component using this config in this process.
+	 * Not replicated, meant for the editor and PIE.
+	 * Returns false if the tuning has no numeric or bool property with that name.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "AdvancedMovement|Config")
+		bool SetTuningValue(FName Property, double Value);
+
+	/**
+	 * The names of the tuning properties, for override pickers.
+	*/
+	UFUNCTION()
+		static TArray<FName> GetTuningPropertyNames();
+
+	//The tuning for components without a config.
+	static const FSymplMovementTuning& GetDefaultTuning() { return GetDefault<USymplMovementConfig>()->Tuning; }
+
+	//Broadcast when the tuning changes after load.
+	FOnTuningChanged OnTuningChanged;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+};
@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Running totals across every movement component, read by the benchmark to measure how the plugin scales.
+ * Only touched from the game thread. Counting compiles out of shipping builds.
+ */
+struct SYMPLADVANCEDMOVEMENT_API FSymplMovementCounters
+{
+	//Component ticks.
+	int64 Ticks = 0;
+
+	//Cycles spent in component ticks.
+	uint64 TickCycles = 0;
+
+	//Sweeps and traces.
+	int64 Traces = 0;
+
+	//Server rpc implementations that ran.
+	int64 ServerRpcs = 0;
+
+	//Multicast rpc implementations that ran.
+	int64 MulticastRpcs = 0;
+
+	//Simulation core steps.
+	int64 SimSteps = 0;
+
+	static FSymplMovementCounters& Get();
+
+	void Reset() { *this = FSymplMovementCounters(); }
+};
+
+#if UE_BUILD_SHIPPING
+
+#define SYMPL_COUNT(Counter, Amount)
+#define SYMPL_SCOPE_TICK_CYCLES()
+
+#else
+
+#define SYMPL_COUNT(Counter, Amount) FSymplMovementCounters::Get().Counter += (Amount)
+
+/**
+ * Adds a tick and the cycles spent in the enclosing scope to the counters.
+ */
+struct FSymplScopedTickCounter
+{
+	uint64 StartCycles;
+
+	FSymplScopedTickCounter() : StartCycles(FPlatformTime::Cycles64()) {}
+	~FSymplScopedTickCounter()
+	{
+		FSymplMovementCounters& counters = FSymplMovementCounters::Get();
+		counters.Ticks++;
+		counters.TickCycles += FPlatformTime::Cycles64() - StartCycles;
+	}
+};
+
+#define SYMPL_SCOPE_TICK_CYCLES() FSymplScopedTickCounter symplScopedTickCounter
+
+#endif
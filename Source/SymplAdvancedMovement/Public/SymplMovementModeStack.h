@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "EAdvancedMovementMode.h"
+#include "SymplMovementStateMachine.h"
+
+/**
+ * Bounded stack of the modes set by active movement states.
+ * Each state has at most one entry, so the stack never holds more than ESymplMovementState::Max entries and never allocates.
+ * Exiting a state removes its entry wherever it is, and the mode goes back to the new top, or BaseMode when the stack is empty.
+ */
+class SYMPLADVANCEDMOVEMENT_API FSymplMovementModeStack
+{
+
+public:
+
+	struct FEntry
+	{
+		//The state that pushed the entry.
+		ESymplMovementState State;
+		//The mode the state set.
+		EAdvancedMovementMode Mode;
+	};
+
+	static constexpr int32 Capacity = (int32)ESymplMovementState::Max;
+
+	FSymplMovementModeStack();
+
+	//Push a mode for State. If State already has an entry it is moved to the top.
+	void Push(ESymplMovementState State, EAdvancedMovementMode Mode);
+
+	//Remove the entry for State. Returns true if it was the top entry.
+	bool Remove(ESymplMovementState State);
+
+	//The mode to use: the top entry, or BaseMode if the stack is empty.
+	EAdvancedMovementMode GetMode() const { return Num > 0 ? Entries[Num - 1].Mode : BaseMode; }
+
+	bool IsEmpty() const { return Num == 0; }
+	int32 GetNum() const { return Num; }
+	const FEntry& operator[](int32 Index) const { check(Index >= 0 && Index < Num); return Entries[Index]; }
+
+	//Clear the stack and set the base mode.
+	void Reset(EAdvancedMovementMode InBaseMode = EAdvancedMovementMode::ENONE);
+
+	//Read or write the stack. Sets an error on the archive if a loaded stack is invalid.
+	void Serialize(FArchive& Ar);
+
+	//The mode we were in before the first entry was pushed.
+	EAdvancedMovementMode BaseMode;
+
+private:
+
+	FEntry Entries[Capacity];
+	int32 Num;
+
+};
@@ -0,0 +1,161 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Pipe.h"
+
+#include "FSymplMovementSnapshot.h"
+
+class IFileHandle;
+
+/**
+ * Movement replay track.
+ * Instead of every replicated property every frame, it records a keyframe of the movement snapshot on each state or mode transition
+ * and at a fixed interval in between. Keyframes are stored as the xor against the previous keyframe, run length encoded,
+ * so fields that didn't change cost almost nothing. Every FullKeyframeInterval keyframes one is stored whole so playback can seek.
+ *
+ * File layout: Magic, FormatVersion, FSymplMovementSnapshot::Version, then records of
+ * type (uint8), server world time (double), full (uint8), raw size (uint16), encoded size (uint16) and the encoded bytes.
+ */
+namespace SymplMovementReplay
+{
+	constexpr uint32 Magic = 0x504D5253; //SRMP
+	constexpr uint8 FormatVersion = 1;
+
+	enum class ERecordType : uint8
+	{
+		//Written because KeyframeInterval passed.
+		Keyframe,
+		//Written because the state flags or movement mode changed.
+		Transition
+	};
+
+	//Run length encode the zero runs in Raw. Appends to Out.
+	SYMPLADVANCEDMOVEMENT_API void Encode(const uint8* Raw, int32 RawSize, TArray<uint8>& Out);
+
+	//Undo Encode into Raw, which must be RawSize bytes. Returns false if the data is corrupt.
+	SYMPLADVANCEDMOVEMENT_API bool Decode(const uint8* Encoded, int32 EncodedSize, uint8* Raw, int32 RawSize);
+
+	//Saved/Replays/SymplMovement/Name.smr, or Name if it is already a full path.
+	SYMPLADVANCEDMOVEMENT_API FString GetReplayPath(const FString& Name);
+}
+
+/**
+ * Appends chunks to a file on a background task so the game thread never waits on disk.
+ * Chunks are written in the order they were queued.
+ */
+class SYMPLADVANCEDMOVEMENT_API FSymplMovementReplayWriter
+{
+
+public:
+
+	FSymplMovementReplayWriter();
+	~FSymplMovementReplayWriter();
+
+	bool Open(const FString& Path);
+
+	//Queue Chunk to be appended to the file.
+	void Write(TArray<uint8>&& Chunk);
+
+	//Wait for the queued chunks and close the file.
+	void Close();
+
+	bool IsOpen() const { return FileHandle.IsValid(); }
+
+private:
+
+	TSharedPtr<IFileHandle> FileHandle;
+	UE::Tasks::FPipe Pipe;
+	UE::Tasks::FTask LastWrite;
+
+};
+
+/**
+ * Records a movement replay track. Call Record once per frame, it only serializes when a keyframe is due.
+ */
+class SYMPLADVANCEDMOVEMENT_API FSymplMovementReplayRecorder
+{
+
+public:
+
+	FSymplMovementReplayRecorder();
+	~FSymplMovementReplayRecorder();
+
+	/**
+	 * Start recording to Path.
+	 * KeyframeInterval is the longest time between keyframes, FullKeyframeInterval how many keyframes apart whole ones are.
+	*/
+	bool Start(const FString& Path, double InKeyframeInterval, int32 InFullKeyframeInterval);
+
+	//Record State at Time if it changed state or mode, or the keyframe interval passed.
+	void Record(double Time, const FSymplMovementSnapshotState& State);
+
+	//Flush and close the file.
+	void Stop();
+
+	bool IsRecording() const { return Writer.IsOpen(); }
+
+private:
+
+	void WriteKeyframe(SymplMovementReplay::ERecordType Type, double Time, const FSymplMovementSnapshotState& State);
+
+	//Hand the pending chunk to the writer.
+	void Flush();
+
+	FSymplMovementReplayWriter Writer;
+
+	//Records waiting to be written.
+	TArray<uint8> Chunk;
+
+	//Scratch buffers, reused for every keyframe.
+	FSymplMovementSnapshot Current;
+	TArray<uint8> LastKeyframe;
+	TArray<uint8> Delta;
+
+	double KeyframeInterval;
+	int32 FullKeyframeInterval;
+	int32 KeyframesSinceFull;
+	double LastKeyframeTime;
+	uint32 LastFlags;
+	EAdvancedMovementMode LastMode;
+
+	//Serialized and written byte counts, for the log on stop.
+	int64 RawBytes;
+	int64 WrittenBytes;
+
+};
+
+/**
+ * Loads a movement replay track and reconstructs the movement state at any time without running the component's tick.
+ */
+class SYMPLADVANCEDMOVEMENT_API FSymplMovementReplayPlayer
+{
+
+public:
+
+	struct FFrame
+	{
+		double Time;
+		SymplMovementReplay::ERecordType Type;
+		FSymplMovementSnapshotState State;
+	};
+
+	//Load and decode the whole track. Returns false if the file is missing, from another version or corrupt.
+	bool Load(const FString& Path);
+
+	/**
+	 * The state at Time. Discrete state is held from the last keyframe at or before Time, velocity, speed, slope and input
+	 * are blended toward the next keyframe unless it is a transition. Returns false if Time is before the first keyframe.
+	*/
+	bool Evaluate(double Time, FSymplMovementSnapshotState& State) const;
+
+	double GetStartTime() const { return Frames.Num() > 0 ? Frames[0].Time : 0.f; }
+	double GetEndTime() const { return Frames.Num() > 0 ? Frames.Last().Time : 0.f; }
+	const TArray<FFrame>& GetFrames() const { return Frames; }
+
+private:
+
+	TArray<FFrame> Frames;
+
+};
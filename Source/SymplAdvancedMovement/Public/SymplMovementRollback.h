@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "FSymplMovementSnapshot.h"
+#include "SymplMovementSimulation.h"
+
+/**
+ * Everything needed to rewind to the start of a fixed tick and step it again.
+ */
+struct SYMPLADVANCEDMOVEMENT_API FSymplMovementRollbackFrame
+{
+	//The fixed tick this is the start of. INDEX_NONE for an unused slot.
+	int32 Frame = INDEX_NONE;
+
+	//The movement state at the start of the tick.
+	FSymplMovementSnapshotState State;
+
+	//The owner's transform and velocity at the start of the tick.
+	FTransform Transform;
+	FVector Velocity = FVector::ZeroVector;
+
+	//The input the tick was stepped with.
+	FSymplMovementSimInput Input;
+};
+
+/**
+ * Fixed capacity ring of rollback frames, indexed by frame number.
+ * Storage is allocated once in Init, adding a frame overwrites the one Capacity frames older.
+ */
+class SYMPLADVANCEDMOVEMENT_API FSymplMovementRollbackBuffer
+{
+
+public:
+
+	//Allocate storage for InCapacity frames and clear the buffer.
+	void Init(int32 InCapacity);
+
+	//Clear the buffer without freeing storage.
+	void Reset();
+
+	//The slot for Frame, to be filled in by the caller.
+	FSymplMovementRollbackFrame& Add(int32 Frame);
+
+	//The stored frame, or null if it was never added or has been overwritten.
+	FSymplMovementRollbackFrame* Find(int32 Frame);
+	const FSymplMovementRollbackFrame* Find(int32 Frame) const;
+
+	//The maximum number of frames.
+	int32 Capacity() const { return Frames.Num(); }
+
+	//The heap memory used by the buffer.
+	SIZE_T GetAllocatedSize() const { return Frames.GetAllocatedSize(); }
+
+private:
+
+	//The frame storage. Frame N lives at N % Capacity.
+	TArray<FSymplMovementRollbackFrame> Frames;
+
+};
@@ -0,0 +1,266 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "EAdvancedMovementMode.h"
+#include "EMovementAnimType.h"
+#include "FSymplResourceMeter.h"
+
+/**
+ * State flags for the movement simulation.
+ */
+enum class ESymplMovementSimFlags : uint32
+{
+	None = 0,
+	Dashing = 1 << 0,
+	Blinking = 1 << 1,
+	Rolling = 1 << 2,
+	Hovering = 1 << 3,
+	Sliding = 1 << 4,
+	Crouching = 1 << 5,
+	Prone = 1 << 6,
+	Sprinting = 1 << 7,
+	JetpackActive = 1 << 8,
+	ZeroG = 1 << 9,
+	Parachuting = 1 << 10,
+	DidJump = 1 << 11,
+	AutoRun = 1 << 12
+};
+ENUM_CLASS_FLAGS(ESymplMovementSimFlags);
+
+/**
+ * Things that happened during a simulation step that the owner of the simulation needs to react to.
+ */
+enum class ESymplMovementSimEvents : uint32
+{
+	None = 0,
+	SpeedChanged = 1 << 0,
+	FuelChanged = 1 << 1,
+	Sliding = 1 << 2,
+	SlideReset = 1 << 3,
+	Dashing = 1 << 4,
+	DashEnded = 1 << 5,
+	Blinking = 1 << 6,
+	BlinkEnded = 1 << 7,
+	Rolling = 1 << 8,
+	RollEnded = 1 << 9,
+	HoverEnded = 1 << 10,
+	ZeroGMoved = 1 << 11,
+	Jetpacking = 1 << 12,
+	StaminaChanged = 1 << 13,
+	StaminaDepleted = 1 << 14,
+	JetpackDepleted = 1 << 15
+};
+ENUM_CLASS_FLAGS(ESymplMovementSimEvents);
+
+/**
+ * Plain old data state of the movement simulation.
+ * Copying this is all it takes to save or restore the simulation.
+ */
+struct SYMPLADVANCEDMOVEMENT_API FSymplMovementSimState
+{
+	//The current movement mode.
+	EAdvancedMovementMode MovementMode = EAdvancedMovementMode::ENONE;
+
+	//The last movement mode.
+	EAdvancedMovementMode LastMovementMode = EAdvancedMovementMode::ENONE;
+
+	//The movement anim type.
+	EMovementAnimType MovementType = EMovementAnimType::ENONE;
+
+	//Active states.
+	ESymplMovementSimFlags Flags = ESymplMovementSimFlags::None;
+
+	//The number of times we have double jumped.
+	int32 DoubleJumpCounter = 0;
+
+	//The owner's velocity.
+	FVector Velocity = FVector::ZeroVector;
+
+	//The current dash direction.
+	FVector DashDirection = FVector::ZeroVector;
+
+	//The current blink direction.
+	FVector BlinkDirection = FVector::ZeroVector;
+
+	//The current roll direction.
+	FVector RollDirection = FVector::ZeroVector;
+
+	//Server world time each ability started at. Negative when the ability isn't running.
+	double DashStartTime = -1.f;
+	double BlinkStartTime = -1.f;
+	double RollStartTime = -1.f;
+	double HoverStartTime = -1.f;
+	double SlideStartTime = -1.f;
+	double ClimbStartTime = -1.f;
+
+	//Jetpack fuel.
+	FSymplResourceMeter JetpackFuel;
+
+	//Sprint stamina.
+	FSymplResourceMeter SprintStamina;
+
+	//The angle of our walking slope.
+	double SlopeAngle = 0.f;
+
+	//The speed scalar for slope angle.
+	double SlopeSpeedScalar = 1.f;
+
+	//The current movement speed.
+	double Speed = 0.f;
+
+	bool Has(ESymplMovementSimFlags Flag) const { return EnumHasAnyFlags(Flags, Flag); }
+	void Set(ESymplMovementSimFlags Flag, bool bValue) { bValue ? EnumAddFlags(Flags, Flag) : EnumRemoveFlags(Flags, Flag); }
+
+	//Time an ability has been running at Time, or 0 if it isn't running.
+	static double GetElapsed(double StartTime, double Time) { return StartTime >= 0.f ? FMath::Max(Time - StartTime, 0.f) : 0.f; }
+};
+
+/**
+ * Tuning values the simulation reads.
+ */
+struct SYMPLADVANCEDMOVEMENT_API FSymplMovementSimConfig
+{
+	double MaxDashTime = 3.f;
+	double MaxBlinkTime = 3.f;
+	double MaxRollTime = 1.f;
+	double MaxHoverTime = 10.f;
+	double MaxSlideTime = 10.f;
+	double DashForce = 1500.f;
+	double BlinkForce = 1500.f;
+	double RollForce = 500.f;
+	double SlideForce = 600.f;
+	double OffsetMoveRate = 60.f;
+	double JetpackAcceleration = 600000.f;
+	double MaxJetpackFuel = 100.f;
+	double RequiredFuelForJetpack = .1f;
+	double JetpackDrainPerSecond = 60.f;
+	double JetpackRefuelPerSecond = 30.f;
+	double MaxSprintStamina = 100.f;
+	double SprintStaminaDrainRate = 20.f;
+	double SprintStaminaRegenRate = 10.f;
+	double RequiredSlideSpeed = 800.f;
+	double RequiredSlideAngle = 30.f;
+	bool bAdjustSpeedToSlope = true;
+	bool bManageCustomSpeed = true;
+	bool bCanSlide = true;
+	bool bIgnoreSlideAngle = true;
+	bool bEnableHover = true;
+	bool bRestoreJetpackFuelWhenInactive = true;
+	bool bUseSprintStamina = false;
+};
+
+/**
+ * Per step input to the simulation, gathered from the owner.
+ */
+struct SYMPLADVANCEDMOVEMENT_API FSymplMovementSimInput
+{
+	//FVector(Forward,Right,Up) input.
+	FVector MoveInput = FVector::ZeroVector;
+
+	//The owner's rotation.
+	FQuat Rotation = FQuat::Identity;
+
+	//The owner's velocity.
+	FVector Velocity = FVector::ZeroVector;
+
+	//The angle of the floor the owner is standing on.
+	double FloorAngle = 0.f;
+
+	//True if the owner is falling.
+	bool bFalling = false;
+
+	//True if the owner is a character.
+	bool bIsCharacter = false;
+
+	//True if we are the server.
+	bool bHasAuthority = false;
+
+	//Synchronized server world time. Ability timers are measured against this.
+	double Time = 0.f;
+
+	//The share of the frame this step covers. Forces that are integrated once per frame are scaled by it.
+	double FrameFraction = 1.f;
+};
+
+/**
+ * World queries the simulation needs. Implemented by the component, or by a stub for tests and benchmarks.
+ */
+class SYMPLADVANCEDMOVEMENT_API ISymplMovementSimQueries
+{
+
+public:
+
+	virtual ~ISymplMovementSimQueries() {}
+
+	//The angle in degrees of the slope under the owner.
+	virtual double QuerySlopeAngle() const = 0;
+
+	//The speed scalar for a slope angle.
+	virtual double QuerySlopeSpeedScalar(double SlopeAngle) const = 0;
+
+	//The base speed for a movement mode. Returns false if the mode has no speed.
+	virtual bool QueryModeSpeed(EAdvancedMovementMode Mode, double& OutSpeed) const = 0;
+
+};
+
+/**
+ * The result of a simulation step.
+ */
+struct SYMPLADVANCEDMOVEMENT_API FSymplMovementSimResult
+{
+	//The new state.
+	FSymplMovementSimState State;
+
+	//What happened during the step.
+	ESymplMovementSimEvents Events = ESymplMovementSimEvents::None;
+
+	//Velocity to launch a character with for dashing, or this step's local offset for other owners.
+	FVector DashLaunch = FVector::ZeroVector;
+
+	//Velocity to launch a character with for blinking, or this step's local offset for other owners.
+	FVector BlinkLaunch = FVector::ZeroVector;
+
+	//Movement input to add to a character for rolling, or this step's local offset for other owners.
+	FVector RollInput = FVector::ZeroVector;
+
+	//Force to add to a character for sliding, or this step's local offset for other owners.
+	FVector SlideForce = FVector::ZeroVector;
+
+	//Velocity to set for the jetpack, the owner's velocity with this step's jetpack acceleration added.
+	FVector JetpackVelocity = FVector::ZeroVector;
+
+	//Jetpack acceleration over the step.
+	FVector JetpackAcceleration = FVector::ZeroVector;
+
+	//This step's share of the frame's jetpack acceleration, for owners simulating physics. Physics integrates the forces added over a frame once.
+	FVector JetpackPhysicsAcceleration = FVector::ZeroVector;
+
+	//This step's jetpack movement, for owners that are moved by offsets.
+	FVector JetpackDelta = FVector::ZeroVector;
+
+	//World location delta for zero g movement.
+	FVector ZeroGDelta = FVector::ZeroVector;
+
+	bool Has(ESymplMovementSimEvents Event) const { return EnumHasAnyFlags(Events, Event); }
+};
+
+/**
+ * Deterministic movement simulation with no UObject or world dependencies.
+ * Step only reads its arguments and returns the new state, so it can be run at a fixed timestep,
+ * in tight loops, or headless for tests and benchmarks.
+ */
+namespace SymplMovementSimulation
+{
+	//Advance the simulation by DeltaTime.
+	SYMPLADVANCEDMOVEMENT_API FSymplMovementSimResult Step(const FSymplMovementSimConfig& Config, const FSymplMovementSimState& State, const FSymplMovementSimInput& Input, double DeltaTime, const ISymplMovementSimQueries& Queries);
+
+	//Condition checks shared with the component.
+	SYMPLADVANCEDMOVEMENT_API bool CanSlide(const FSymplMovementSimConfig& Config, const FSymplMovementSimState& State, const FSymplMovementSimInput& Input);
+	SYMPLADVANCEDMOVEMENT_API bool CanDash(const FSymplMovementSimConfig& Config, const FSymplMovementSimState& State, double Time);
+	SYMPLADVANCEDMOVEMENT_API bool CanBlink(const FSymplMovementSimConfig& Config, const FSymplMovementSimState& State, double Time);
+	SYMPLADVANCEDMOVEMENT_API bool CanRoll(const FSymplMovementSimConfig& Config, const FSymplMovementSimState& State, double Time);
+	SYMPLADVANCEDMOVEMENT_API bool CanHover(const FSymplMovementSimConfig& Config, const FSymplMovementSimState& State, double Time);
+}
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "EAdvancedMovementMode.h"
+#include "SymplMovementSimulation.h"
+
+/**
+ * Movement states driven by the state machine. Each one owns a single ESymplMovementSimFlags bit.
+ */
+enum class ESymplMovementState : uint8
+{
+	Dashing,
+	Blinking,
+	Rolling,
+	Hovering,
+	Sliding,
+	Crouching,
+	Prone,
+	Sprinting,
+	Jetpack,
+	ZeroG,
+	Parachuting,
+	Max
+};
+
+/**
+ * One row of the transition table.
+ */
+struct FSymplMovementStateRule
+{
+	//The flag this state owns.
+	ESymplMovementSimFlags Flag;
+
+	//The state can't be entered while any of these are active.
+	ESymplMovementSimFlags BlockedBy;
+
+	//States that are exited when this state is entered.
+	ESymplMovementSimFlags Exits;
+
+	//The movement mode set on enter. ENONE keeps the current mode.
+	EAdvancedMovementMode Mode;
+
+	//If true, the mode goes back to the next state down the mode stack on exit.
+	bool bRestoreModeOnExit;
+};
+
+/**
+ * Compile time transition table for the movement states.
+ * Legality checks are a single lookup and a mask test, and entering a state exits everything it excludes,
+ * so illegal combinations can't be stored.
+ */
+namespace SymplMovementStateMachine
+{
+	//Dash, blink and roll block each other.
+	constexpr ESymplMovementSimFlags Abilities = ESymplMovementSimFlags::Dashing | ESymplMovementSimFlags::Blinking | ESymplMovementSimFlags::Rolling;
+
+	//Crouching, prone and sprinting replace each other.
+	constexpr ESymplMovementSimFlags Stances = ESymplMovementSimFlags::Crouching | ESymplMovementSimFlags::Prone | ESymplMovementSimFlags::Sprinting;
+
+	//Every flag owned by a state.
+	constexpr ESymplMovementSimFlags AllStates = Abilities | Stances | ESymplMovementSimFlags::Hovering | ESymplMovementSimFlags::Sliding
+		| ESymplMovementSimFlags::JetpackActive | ESymplMovementSimFlags::ZeroG | ESymplMovementSimFlags::Parachuting;
+
+	//States that block standard movement input.
+	constexpr ESymplMovementSimFlags MoveBlockers = ESymplMovementSimFlags::Sliding | ESymplMovementSimFlags::Dashing | ESymplMovementSimFlags::Rolling | ESymplMovementSimFlags::Hovering;
+
+	constexpr FSymplMovementStateRule Rules[(int32)ESymplMovementState::Max] =
+	{
+		//Dashing
+		{ ESymplMovementSimFlags::Dashing, ESymplMovementSimFlags::Blinking | ESymplMovementSimFlags::Rolling, ESymplMovementSimFlags::None, EAdvancedMovementMode::EDASH, true },
+		//Blinking
+		{ ESymplMovementSimFlags::Blinking, ESymplMovementSimFlags::Dashing | ESymplMovementSimFlags::Rolling, ESymplMovementSimFlags::None, EAdvancedMovementMode::EBLINK, true },
+		//Rolling
+		{ ESymplMovementSimFlags::Rolling, ESymplMovementSimFlags::Dashing | ESymplMovementSimFlags::Blinking, ESymplMovementSimFlags::None, EAdvancedMovementMode::EROLL, true },
+		//Hovering
+		{ ESymplMovementSimFlags::Hovering, ESymplMovementSimFlags::Parachuting, ESymplMovementSimFlags::Sliding, EAdvancedMovementMode::EHOVER, true },
+		//Sliding
+		{ ESymplMovementSimFlags::Sliding, ESymplMovementSimFlags::Hovering, ESymplMovementSimFlags::Crouching, EAdvancedMovementMode::EJUMP, true },
+		//Crouching
+		{ ESymplMovementSimFlags::Crouching, ESymplMovementSimFlags::None, ESymplMovementSimFlags::Prone | ESymplMovementSimFlags::Sprinting | ESymplMovementSimFlags::Sliding, EAdvancedMovementMode::ECROUCH, true },
+		//Prone
+		{ ESymplMovementSimFlags::Prone, ESymplMovementSimFlags::None, ESymplMovementSimFlags::Crouching | ESymplMovementSimFlags::Sprinting, EAdvancedMovementMode::EPRONE, true },
+		//Sprinting
+		{ ESymplMovementSimFlags::Sprinting, ESymplMovementSimFlags::None, ESymplMovementSimFlags::Crouching | ESymplMovementSimFlags::Prone, EAdvancedMovementMode::ESPRINT, true },
+		//Jetpack
+		{ ESymplMovementSimFlags::JetpackActive, ESymplMovementSimFlags::None, ESymplMovementSimFlags::Hovering, EAdvancedMovementMode::EJETPACK, true },
+		//ZeroG
+		{ ESymplMovementSimFlags::ZeroG, ESymplMovementSimFlags::Parachuting, ESymplMovementSimFlags::Hovering | ESymplMovementSimFlags::Sliding, EAdvancedMovementMode::EZEROG, true },
+		//Parachuting
+		{ ESymplMovementSimFlags::Parachuting, ESymplMovementSimFlags::Hovering | ESymplMovementSimFlags::ZeroG, ESymplMovementSimFlags::None, EAdvancedMovementMode::EPARACHUTE, true }
+	};
+
+	constexpr const FSymplMovementStateRule& GetRule(ESymplMovementState State) { return Rules[(int32)State]; }
+
+	constexpr bool IsActive(ESymplMovementSimFlags Flags, ESymplMovementState State) { return (Flags & GetRule(State).Flag) != ESymplMovementSimFlags::None; }
+
+	//True if the state can be entered from Flags.
+	constexpr bool CanEnter(ESymplMovementSimFlags Flags, ESymplMovementState State) { return (Flags & GetRule(State).BlockedBy) == ESymplMovementSimFlags::None; }
+
+	//True if nothing in Flags blocks standard movement input.
+	constexpr bool CanMove(ESymplMovementSimFlags Flags) { return (Flags & MoveBlockers) == ESymplMovementSimFlags::None; }
+
+	//The states that are active in Flags and would be exited by entering State.
+	constexpr ESymplMovementSimFlags GetExits(ESymplMovementSimFlags Flags, ESymplMovementState State) { return Flags & GetRule(State).Exits; }
+
+	//Debug name for logging.
+	SYMPLADVANCEDMOVEMENT_API const TCHAR* GetStateName(ESymplMovementState State);
+}
@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * Profiling for the advanced movement plugin.
+ * SYMPL_SCOPE adds a scoped cycle counter to the SymplMovement stat group ("stat SymplMovement")
+ * and a cpu event on the SymplMovement trace channel for Unreal Insights ("-trace=cpu,SymplMovement").
+ * Everything compiles out of shipping builds.
+ */
+#ifndef SYMPL_MOVEMENT_STATS
+#define SYMPL_MOVEMENT_STATS !UE_BUILD_SHIPPING
+#endif
+
+#if SYMPL_MOVEMENT_STATS
+
+DECLARE_STATS_GROUP(TEXT("SymplMovement"), STATGROUP_SymplMovement, STATCAT_Advanced);
+
+UE_TRACE_CHANNEL_EXTERN(SymplMovementChannel, SYMPLADVANCEDMOVEMENT_API);
+
+#define SYMPL_SCOPE(Name) \
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT(#Name), STAT_SymplMovement_##Name, STATGROUP_SymplMovement); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(SymplMovement_##Name, SymplMovementChannel)
+
+#else
+
+#define SYMPL_SCOPE(Name)
+
+#endif
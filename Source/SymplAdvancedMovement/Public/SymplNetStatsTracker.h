@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "ESymplMovementRpc.h"
+#include "FSymplMovementNetStats.h"
+
+/**
+ * Per rpc and per replicated property counters with one second rate windows.
+ * Each component owns one, so the stats are per player.
+ */
+class SYMPLADVANCEDMOVEMENT_API FSymplNetStatsTracker
+{
+
+public:
+
+	FSymplNetStatsTracker();
+
+	//Count a call to Rpc.
+	void RecordRpc(ESymplMovementRpc Rpc, int32 Bytes, bool bReliable, float ReliableBufferPressure);
+
+	//Set the tracked property names. Clears the property counters.
+	void InitProperties(const TArray<FName>& Names);
+
+	//True if InitProperties has been called.
+	bool HasProperties() const { return PropertyNames.Num() > 0; }
+
+	//Count a change to the property at Index.
+	void RecordProperty(int32 Index, int32 Bytes);
+
+	//Close the current window and compute rates if WindowSeconds have passed.
+	void Update(double Time, double WindowSeconds = 1.f);
+
+	//Copy the stats out.
+	void Fill(FSymplMovementNetStats& OutStats) const;
+
+	//Clear every counter.
+	void Reset();
+
+private:
+
+	struct FCounter
+	{
+		//Totals.
+		int32 Count = 0;
+		int64 Bytes = 0;
+		//Counts in the current window.
+		int32 WindowCount = 0;
+		int32 WindowBytes = 0;
+		float WindowPressure = 0.f;
+		//Rates from the last closed window.
+		float CountRate = 0.f;
+		float ByteRate = 0.f;
+		float Pressure = 0.f;
+		bool bReliable = false;
+	};
+
+	void CloseWindow(FCounter& Counter, double Elapsed);
+
+	//One counter per rpc.
+	FCounter Rpcs[(int32)ESymplMovementRpc::EMAX];
+
+	TArray<FCounter> Properties;
+	TArray<FName> PropertyNames;
+
+	//When the current window opened. Negative until the first update.
+	double WindowStart;
+
+};
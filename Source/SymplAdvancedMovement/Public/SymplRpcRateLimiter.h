@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "ESymplMovementRpc.h"
+#include "FSymplRpcRateLimit.h"
+
+/**
+ * Per rpc token buckets and rejection counters.
+ * Each component owns one, so the limits apply per owning connection.
+ */
+class SYMPLADVANCEDMOVEMENT_API FSymplRpcRateLimiter
+{
+
+public:
+
+	FSymplRpcRateLimiter();
+
+	//Try to spend a token for Rpc at Time. Returns false and counts a rejection if the bucket is empty.
+	bool TryConsume(ESymplMovementRpc Rpc, double Time, const FSymplRpcRateLimit& Limit);
+
+	//Count a rejection that happened for another reason (i.e. a failed plausibility check).
+	void AddRejected(ESymplMovementRpc Rpc);
+
+	//The number of rejected calls for Rpc.
+	int32 GetRejectedCount(ESymplMovementRpc Rpc) const;
+
+	//The number of rejected calls for every rpc.
+	int32 GetTotalRejectedCount() const { return TotalRejected; }
+
+	//Refill every bucket and clear the counters.
+	void Reset();
+
+private:
+
+	struct FBucket
+	{
+		//Tokens left. Negative means the bucket has not been used yet.
+		double Tokens;
+		//The last time the bucket was refilled.
+		double LastTime;
+		//The number of rejected calls.
+		int32 Rejected;
+	};
+
+	//One bucket per rpc.
+	FBucket Buckets[(int32)ESymplMovementRpc::EMAX];
+
+	//The number of rejected calls for every rpc.
+	int32 TotalRejected;
+
+};
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "FSymplTrajectorySample.h"
+
+/**
+ * Fixed capacity ring buffer of trajectory samples.
+ * Storage is allocated once in Init, adding a sample overwrites the oldest one.
+ */
+class SYMPLADVANCEDMOVEMENT_API FSymplTrajectoryHistory
+{
+
+public:
+
+	FSymplTrajectoryHistory();
+
+	//Allocate storage for InCapacity samples and clear the history.
+	void Init(int32 InCapacity);
+
+	//Clear the history without freeing storage.
+	void Reset();
+
+	//Add a sample, overwriting the oldest one if full.
+	void Add(const FSymplTrajectorySample& Sample);
+
+	//The number of recorded samples.
+	int32 Num() const { return Count; }
+
+	//The maximum number of samples.
+	int32 Capacity() const { return Samples.Num(); }
+
+	//Get a sample where 0 is the newest.
+	const FSymplTrajectorySample& GetFromNewest(int32 Index) const;
+
+	//Get the interpolated sample at Time. Returns false if Time is older than the history.
+	bool SampleAtTime(double Time, FSymplTrajectorySample& OutSample) const;
+
+	//Find the newest sample at or before Time with the given grounded state.
+	bool FindNewest(bool bGrounded, double BeforeTime, FSymplTrajectorySample& OutSample) const;
+
+	//Copy the history into OutSamples from oldest to newest.
+	void CopyTo(TArray<FSymplTrajectorySample>& OutSamples) const;
+
+	//The heap memory used by the history.
+	SIZE_T GetAllocatedSize() const { return Samples.GetAllocatedSize(); }
+
+private:
+
+	//The sample storage.
+	TArray<FSymplTrajectorySample> Samples;
+
+	//The index the next sample will be written to.
+	int32 Head;
+
+	//The number of valid samples.
+	int32 Count;
+
+};
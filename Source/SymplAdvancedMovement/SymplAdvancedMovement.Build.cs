@@ -38,6 +38,9 @@ public class SymplAdvancedMovement : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"SignificanceManager",
+				"DeveloperSettings",
+				"AIModule",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);